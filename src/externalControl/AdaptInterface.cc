@@ -17,6 +17,7 @@
 #include <sstream>
 #include <boost/tokenizer.hpp>
 #include <managers/execution/ExecutionManagerMod.h>
+#include <modules/RequestClass.h>
 
 Define_Module(AdaptInterface);
 
@@ -34,6 +35,7 @@ AdaptInterface::AdaptInterface() {
     commandHandlers["add_server"] = std::bind(&AdaptInterface::cmdAddServer, this, std::placeholders::_1);
     commandHandlers["remove_server"] = std::bind(&AdaptInterface::cmdRemoveServer, this, std::placeholders::_1);
     commandHandlers["set_dimmer"] = std::bind(&AdaptInterface::cmdSetDimmer, this, std::placeholders::_1);
+    commandHandlers["set_admission_rate"] = std::bind(&AdaptInterface::cmdSetAdmissionRate, this, std::placeholders::_1);
 
 
     // get commands
@@ -47,6 +49,31 @@ AdaptInterface::AdaptInterface() {
     commandHandlers["get_opt_rt"] = std::bind(&AdaptInterface::cmdGetOptResponseTime, this, std::placeholders::_1);
     commandHandlers["get_opt_throughput"] = std::bind(&AdaptInterface::cmdGetOptThroughput, this, std::placeholders::_1);
     commandHandlers["get_arrival_rate"] = std::bind(&AdaptInterface::cmdGetArrivalRate, this, std::placeholders::_1);
+    commandHandlers["get_admission_rate"] = std::bind(&AdaptInterface::cmdGetAdmissionRate, this, std::placeholders::_1);
+    commandHandlers["get_rejected_rate"] = std::bind(&AdaptInterface::cmdGetRejectedRate, this, std::placeholders::_1);
+    commandHandlers["get_timed_out_rate"] = std::bind(&AdaptInterface::cmdGetTimedOutRate, this, std::placeholders::_1);
+    for (int percentile : {50, 95, 99}) {
+        string suffix = "_rt_p" + to_string(percentile);
+        commandHandlers["get_basic" + suffix] = std::bind(&AdaptInterface::cmdGetBasicResponseTimePercentile, this, std::placeholders::_1, percentile);
+        commandHandlers["get_opt" + suffix] = std::bind(&AdaptInterface::cmdGetOptResponseTimePercentile, this, std::placeholders::_1, percentile);
+    }
+    for (bool basic : {true, false}) {
+        string prefix = (basic) ? "get_basic_" : "get_opt_";
+        commandHandlers[prefix + "queue_time"] = std::bind(&AdaptInterface::cmdGetLatencyBreakdown, this, std::placeholders::_1, basic, &Observations::LatencyBreakdown::queueTime);
+        commandHandlers[prefix + "service_time"] = std::bind(&AdaptInterface::cmdGetLatencyBreakdown, this, std::placeholders::_1, basic, &Observations::LatencyBreakdown::serviceTime);
+        commandHandlers[prefix + "slowdown"] = std::bind(&AdaptInterface::cmdGetLatencyBreakdown, this, std::placeholders::_1, basic, &Observations::LatencyBreakdown::slowdown);
+    }
+    commandHandlers["get_queue_length"] = std::bind(&AdaptInterface::cmdGetLoadGauge, this, std::placeholders::_1, &Observations::LoadGauges::queueLength);
+    commandHandlers["get_running_jobs"] = std::bind(&AdaptInterface::cmdGetLoadGauge, this, std::placeholders::_1, &Observations::LoadGauges::runningJobs);
+    commandHandlers["get_timed_out_count"] = std::bind(&AdaptInterface::cmdGetLoadGauge, this, std::placeholders::_1, &Observations::LoadGauges::timedOut);
+    commandHandlers["get_rejected_count"] = std::bind(&AdaptInterface::cmdGetLoadGauge, this, std::placeholders::_1, &Observations::LoadGauges::rejected);
+    commandHandlers["set_class_dimmer"] = std::bind(&AdaptInterface::cmdSetClassDimmer, this, std::placeholders::_1);
+    commandHandlers["get_class_dimmer"] = std::bind(&AdaptInterface::cmdGetClassDimmer, this, std::placeholders::_1);
+    commandHandlers["get_class_rt"] = std::bind(&AdaptInterface::cmdGetClassObservation, this, std::placeholders::_1, &Observations::ClassObservations::responseTime);
+    commandHandlers["get_class_throughput"] = std::bind(&AdaptInterface::cmdGetClassObservation, this, std::placeholders::_1, &Observations::ClassObservations::throughput);
+    commandHandlers["get_class_basic_throughput"] = std::bind(&AdaptInterface::cmdGetClassObservation, this, std::placeholders::_1, &Observations::ClassObservations::basicThroughput);
+    commandHandlers["get_class_late_rate"] = std::bind(&AdaptInterface::cmdGetClassObservation, this, std::placeholders::_1, &Observations::ClassObservations::lateRate);
+    commandHandlers["get_forecast"] = std::bind(&AdaptInterface::cmdGetForecast, this, std::placeholders::_1);
 
     // dimmer, numServers, numActiveServers, utilization(total or indiv), response time and throughput for mandatory and optional, avg arrival rate
 }
@@ -62,6 +89,7 @@ void AdaptInterface::initialize()
     rtScheduler->setInterfaceModule(this, rtEvent, recvBuffer, BUFFER_SIZE, &numRecvBytes);
     pModel = check_and_cast<Model*> (getParentModule()->getSubmodule("model"));
     pProbe = check_and_cast<IProbe*> (gate("probe")->getPreviousGate()->getOwnerModule());
+    forecast.initialize(this);
 }
 
 void AdaptInterface::handleMessage(cMessage *msg)
@@ -136,6 +164,21 @@ std::string AdaptInterface::cmdSetDimmer(const std::vector<std::string>& args) {
     return COMMAND_SUCCESS;
 }
 
+std::string AdaptInterface::cmdSetAdmissionRate(const std::vector<std::string>& args) {
+    if (args.size() == 0) {
+        return "error: missing admission rate argument\n";
+    }
+
+    double rate = atof(args[0].c_str());
+    if (rate < 0) {
+        return "error: admission rate must be >= 0\n";
+    }
+    ExecutionManagerModBase* pExecMgr = check_and_cast<ExecutionManagerModBase*> (getParentModule()->getSubmodule("executionManager"));
+    pExecMgr->setAdmissionRate(rate);
+
+    return COMMAND_SUCCESS;
+}
+
 
 std::string AdaptInterface::cmdGetDimmer(const std::vector<std::string>& args) {
     ostringstream reply;
@@ -228,3 +271,148 @@ std::string AdaptInterface::cmdGetArrivalRate(
 
     return reply.str();
 }
+
+std::string AdaptInterface::cmdGetAdmissionRate(
+        const std::vector<std::string>& args) {
+    ostringstream reply;
+    reply << pModel->getAdmissionRate() << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetRejectedRate(
+        const std::vector<std::string>& args) {
+    ostringstream reply;
+    reply << pProbe->getRejectedRate() << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetTimedOutRate(
+        const std::vector<std::string>& args) {
+    ostringstream reply;
+    reply << pProbe->getTimedOutRate() << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetBasicResponseTimePercentile(
+        const std::vector<std::string>& args, double percentile) {
+    ostringstream reply;
+    reply << pProbe->getBasicResponseTimePercentile(percentile) << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetOptResponseTimePercentile(
+        const std::vector<std::string>& args, double percentile) {
+    ostringstream reply;
+    reply << pProbe->getOptResponseTimePercentile(percentile) << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetLatencyBreakdown(
+        const std::vector<std::string>& args, bool basic,
+        double Observations::LatencyBreakdown::* field) {
+    string serverName = (args.size() > 0) ? args[0] : "";
+    ostringstream reply;
+    reply << pProbe->getLatencyBreakdown(serverName, basic).*field << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetLoadGauge(
+        const std::vector<std::string>& args,
+        long Observations::LoadGauges::* field) {
+    string serverName = (args.size() > 0) ? args[0] : "";
+    ostringstream reply;
+    reply << pProbe->getLoadGauges(serverName).*field << '\n';
+
+    return reply.str();
+}
+
+bool AdaptInterface::parseRequestClass(const std::vector<std::string>& args, unsigned& requestClass) const {
+    if (args.size() == 0) {
+        return false;
+    }
+    int index = atoi(args[0].c_str());
+    if (index < 0 || index >= (int) RequestClass::getCount()) {
+        return false;
+    }
+    requestClass = index;
+    return true;
+}
+
+std::string AdaptInterface::cmdSetClassDimmer(const std::vector<std::string>& args) {
+    unsigned requestClass;
+    if (!parseRequestClass(args, requestClass)) {
+        return "error: missing or invalid request class argument\n";
+    }
+    if (args.size() < 2) {
+        return "error: missing dimmer argument\n";
+    }
+
+    double dimmer = atof(args[1].c_str());
+    ExecutionManagerModBase* pExecMgr = check_and_cast<ExecutionManagerModBase*> (getParentModule()->getSubmodule("executionManager"));
+    pExecMgr->setClassBrownout(requestClass, 1 - dimmer);
+
+    return COMMAND_SUCCESS;
+}
+
+std::string AdaptInterface::cmdGetClassDimmer(const std::vector<std::string>& args) {
+    unsigned requestClass;
+    if (!parseRequestClass(args, requestClass)) {
+        return "error: missing or invalid request class argument\n";
+    }
+
+    ostringstream reply;
+    reply << (1 - pModel->getClassBrownoutFactor(requestClass)) << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetClassObservation(
+        const std::vector<std::string>& args,
+        double Observations::ClassObservations::* field) {
+    unsigned requestClass;
+    if (!parseRequestClass(args, requestClass)) {
+        return "error: missing or invalid request class argument\n";
+    }
+
+    ostringstream reply;
+    reply << pProbe->getClassObservations(requestClass).*field << '\n';
+
+    return reply.str();
+}
+
+std::string AdaptInterface::cmdGetForecast(const std::vector<std::string>& args) {
+    if (!forecast.isAvailable()) {
+        return "error: the source does not predict its arrivals\n";
+    }
+
+    double start = (args.size() > 0) ? atof(args[0].c_str()) : 0;
+    double window = (args.size() > 1) ? atof(args[1].c_str()) : pModel->getEvaluationPeriod();
+    long steps = (args.size() > 2) ? strtol(args[2].c_str(), nullptr, 10) : 1;
+    double noise = (args.size() > 3) ? atof(args[3].c_str()) : -1;
+    if (start < 0 || window <= 0 || steps < 1) {
+        return "error: invalid start, window or steps argument\n";
+    }
+    if (steps > (long) SourceForecast::MAX_WINDOWS) {
+        return "error: at most " + std::to_string(SourceForecast::MAX_WINDOWS) + " steps\n";
+    }
+
+    std::vector<SourceForecast::Window> windows;
+    forecast.get(start, window, steps, noise, windows);
+
+    ostringstream reply;
+    for (unsigned w = 0; w < windows.size(); w++) {
+        if (w > 0) {
+            reply << ' ';
+        }
+        reply << windows[w].meanInterArrival << ' ' << windows[w].variance;
+    }
+    reply << '\n';
+
+    return reply.str();
+}
@@ -23,6 +23,7 @@
 #include <map>
 #include "model/Model.h"
 #include "managers/monitor/IProbe.h"
+#include "SourceForecast.h"
 
 /**
  * Adaptation interface (probes and effectors)
@@ -37,6 +38,7 @@ protected:
     std::map<std::string, std::function<std::string(const std::vector<std::string>&)>> commandHandlers;
     Model* pModel;
     IProbe* pProbe;
+    SourceForecast forecast;
 
     virtual void initialize();
     virtual void handleMessage(cMessage *msg);
@@ -44,6 +46,7 @@ protected:
     virtual std::string cmdAddServer(const std::vector<std::string>& args);
     virtual std::string cmdRemoveServer(const std::vector<std::string>& args);
     virtual std::string cmdSetDimmer(const std::vector<std::string>& args);
+    virtual std::string cmdSetAdmissionRate(const std::vector<std::string>& args);
 
     virtual std::string cmdGetDimmer(const std::vector<std::string>& args);
     virtual std::string cmdGetServers(const std::vector<std::string>& args);
@@ -55,6 +58,53 @@ protected:
     virtual std::string cmdGetOptResponseTime(const std::vector<std::string>& args);
     virtual std::string cmdGetOptThroughput(const std::vector<std::string>& args);
     virtual std::string cmdGetArrivalRate(const std::vector<std::string>& args);
+    virtual std::string cmdGetAdmissionRate(const std::vector<std::string>& args);
+    virtual std::string cmdGetRejectedRate(const std::vector<std::string>& args);
+    virtual std::string cmdGetTimedOutRate(const std::vector<std::string>& args);
+    virtual std::string cmdGetBasicResponseTimePercentile(const std::vector<std::string>& args, double percentile);
+    virtual std::string cmdGetOptResponseTimePercentile(const std::vector<std::string>& args, double percentile);
+
+    /**
+     * Replies with a field of the latency breakdown, for the server in the
+     * optional argument, or for all the servers
+     */
+    virtual std::string cmdGetLatencyBreakdown(const std::vector<std::string>& args, bool basic,
+            double Observations::LatencyBreakdown::* field);
+
+    /**
+     * Replies with a load gauge, for the server in the optional argument, or
+     * for all the servers
+     */
+    virtual std::string cmdGetLoadGauge(const std::vector<std::string>& args,
+            long Observations::LoadGauges::* field);
+
+    virtual std::string cmdSetClassDimmer(const std::vector<std::string>& args);
+    virtual std::string cmdGetClassDimmer(const std::vector<std::string>& args);
+
+    /**
+     * Replies with a statistic of the request class in the argument
+     */
+    virtual std::string cmdGetClassObservation(const std::vector<std::string>& args,
+            double Observations::ClassObservations::* field);
+
+    /**
+     * Parses the request class argument
+     *
+     * @return false if it is missing or not a valid class
+     */
+    bool parseRequestClass(const std::vector<std::string>& args, unsigned& requestClass) const;
+
+    /**
+     * Replies with the forecast of the arrivals, as the mean and variance of
+     * the interarrival time of each window, all in one line
+     *
+     * The optional arguments are the start of the first window relative to
+     * now, the window duration, the number of windows, and the noise (see
+     * SourceForecast). They default to now, the evaluation period, one
+     * window, and the forecastNoise parameter. At most
+     * SourceForecast::MAX_WINDOWS windows can be requested.
+     */
+    virtual std::string cmdGetForecast(const std::vector<std::string>& args);
 
 private:
     static const unsigned BUFFER_SIZE = 4000;
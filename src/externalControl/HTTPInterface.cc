@@ -57,6 +57,7 @@ HTTPInterface::HTTPInterface(){
     endpointGETHandlers["/execute_schema"] = std::bind(&HTTPInterface::epExecuteSchema, this, std::placeholders::_1);
     endpointGETHandlers["/adaptation_options"] = std::bind(&HTTPInterface::epAdapOptions, this, std::placeholders::_1);
     endpointGETHandlers["/adaptation_options_schema"] = std::bind(&HTTPInterface::epAdapOptSchema, this, std::placeholders::_1);
+    endpointGETHandlers["/forecast"] = std::bind(&HTTPInterface::epForecast, this, std::placeholders::_1);
 
     // PUT Request
     endpointPUTHandlers["/execute"] = std::bind(&HTTPInterface::epExecute, this, std::placeholders::_1);
@@ -67,7 +68,11 @@ HTTPInterface::HTTPInterface(){
     integerMonitorable = {
             {"servers", &servers},
             {"active_servers", &active_servers},
-            {"max_servers", &max_servers}};
+            {"max_servers", &max_servers},
+            {"queue_length", &queue_length},
+            {"running_jobs", &running_jobs},
+            {"timed_out_count", &timed_out_count},
+            {"rejected_count", &rejected_count}};
 
     doubleMonitorable = {
             {"dimmer_factor", &dimmer_factor},
@@ -75,7 +80,22 @@ HTTPInterface::HTTPInterface(){
             {"basic_throughput", &basic_throughput},
             {"opt_throughput", &opt_throughput},
             {"opt_rt", &opt_rt},
-            {"arrival_rate", &arrival_rate}};
+            {"arrival_rate", &arrival_rate},
+            {"admission_rate", &admission_rate},
+            {"rejected_rate", &rejected_rate},
+            {"timed_out_rate", &timed_out_rate},
+            {"basic_rt_p50", &basic_rt_p50},
+            {"basic_rt_p95", &basic_rt_p95},
+            {"basic_rt_p99", &basic_rt_p99},
+            {"opt_rt_p50", &opt_rt_p50},
+            {"opt_rt_p95", &opt_rt_p95},
+            {"opt_rt_p99", &opt_rt_p99},
+            {"basic_queue_time", &basic_queue_time},
+            {"basic_service_time", &basic_service_time},
+            {"basic_slowdown", &basic_slowdown},
+            {"opt_queue_time", &opt_queue_time},
+            {"opt_service_time", &opt_service_time},
+            {"opt_slowdown", &opt_slowdown}};
 }
 
 HTTPInterface::~HTTPInterface(){
@@ -88,6 +108,7 @@ void HTTPInterface::initialize(){
     rtScheduler->setInterfaceModule(this, rtEvent, recvBuffer, BUFFER_SIZE, &numRecvBytes);
     pModel = check_and_cast<Model*> (getParentModule()->getSubmodule("model"));
     pProbe = check_and_cast<IProbe*> (gate("probe")->getPreviousGate()->getOwnerModule());
+    forecast.initialize(this);
 }
 
 bool HTTPInterface::parseMessage(){
@@ -114,6 +135,15 @@ bool HTTPInterface::parseMessage(){
     http_rq_type = http_request[0];
     http_rq_endpoint = http_request[1];
 
+    // the query string is not part of the endpoint
+    size_t query_pos = http_rq_endpoint.find('?');
+    if (query_pos != std::string::npos) {
+        http_rq_query = http_rq_endpoint.substr(query_pos + 1);
+        http_rq_endpoint.erase(query_pos);
+    } else {
+        http_rq_query = "";
+    }
+
     if(lines.size() > 0){
         http_rq_body = lines.back();
     }
@@ -204,7 +234,34 @@ void HTTPInterface::updateMonitoring(){
     opt_throughput = pProbe->getOptThroughput();
     opt_rt = pProbe->getOptResponseTime();
     arrival_rate = pProbe->getArrivalRate();
+    admission_rate = pModel->getAdmissionRate();
+    rejected_rate = pProbe->getRejectedRate();
+    timed_out_rate = pProbe->getTimedOutRate();
+    basic_rt_p50 = pProbe->getBasicResponseTimePercentile(50);
+    basic_rt_p95 = pProbe->getBasicResponseTimePercentile(95);
+    basic_rt_p99 = pProbe->getBasicResponseTimePercentile(99);
+    opt_rt_p50 = pProbe->getOptResponseTimePercentile(50);
+    opt_rt_p95 = pProbe->getOptResponseTimePercentile(95);
+    opt_rt_p99 = pProbe->getOptResponseTimePercentile(99);
+
+    Observations::LatencyBreakdown basicLatency = pProbe->getLatencyBreakdown("", true);
+    basic_queue_time = basicLatency.queueTime;
+    basic_service_time = basicLatency.serviceTime;
+    basic_slowdown = basicLatency.slowdown;
+    Observations::LatencyBreakdown optLatency = pProbe->getLatencyBreakdown("", false);
+    opt_queue_time = optLatency.queueTime;
+    opt_service_time = optLatency.serviceTime;
+    opt_slowdown = optLatency.slowdown;
+
+    Observations::LoadGauges totalLoad = pProbe->getLoadGauges("");
+    queue_length = totalLoad.queueLength;
+    running_jobs = totalLoad.runningJobs;
+    timed_out_count = totalLoad.timedOut;
+    rejected_count = totalLoad.rejected;
+
     utilization = HTTPInterface::allUtilization();
+    latency = HTTPInterface::allLatency();
+    load = HTTPInterface::allLoad();
 }
 
 boost::property_tree::ptree HTTPInterface::allUtilization(){
@@ -230,6 +287,51 @@ boost::property_tree::ptree HTTPInterface::allUtilization(){
     return server_array_ptree;
 }
 
+boost::property_tree::ptree HTTPInterface::allLatency(){
+    int servers = pModel->getServers();
+    boost::property_tree::ptree server_array_ptree;
+
+    for(int i = 1; i <= servers; i++) {
+        boost::property_tree::ptree server;
+        std::string server_name = "server" + std::to_string(i);
+        Observations::LatencyBreakdown basicLatency = pProbe->getLatencyBreakdown(server_name, true);
+        Observations::LatencyBreakdown optLatency = pProbe->getLatencyBreakdown(server_name, false);
+
+        server.put("server_name", server_name);
+        server.put("basic_queue_time", basicLatency.queueTime);
+        server.put("basic_service_time", basicLatency.serviceTime);
+        server.put("basic_slowdown", basicLatency.slowdown);
+        server.put("opt_queue_time", optLatency.queueTime);
+        server.put("opt_service_time", optLatency.serviceTime);
+        server.put("opt_slowdown", optLatency.slowdown);
+
+        server_array_ptree.push_back(std::make_pair("", server));
+    }
+
+    return server_array_ptree;
+}
+
+boost::property_tree::ptree HTTPInterface::allLoad(){
+    int servers = pModel->getServers();
+    boost::property_tree::ptree server_array_ptree;
+
+    for(int i = 1; i <= servers; i++) {
+        boost::property_tree::ptree server;
+        std::string server_name = "server" + std::to_string(i);
+        Observations::LoadGauges serverLoad = pProbe->getLoadGauges(server_name);
+
+        server.put("server_name", server_name);
+        server.put("queue_length", serverLoad.queueLength);
+        server.put("running_jobs", serverLoad.runningJobs);
+        server.put("timed_out_count", serverLoad.timedOut);
+        server.put("rejected_count", serverLoad.rejected);
+
+        server_array_ptree.push_back(std::make_pair("", server));
+    }
+
+    return server_array_ptree;
+}
+
 template <class T>
 void HTTPInterface::putInJSON (boost::property_tree::ptree& json_file, std::map<std::string, T*>& some_map){
     for (auto const& map_entry : some_map){
@@ -261,6 +363,8 @@ bool HTTPInterface::epMonitor(const std::string& arg){
     HTTPInterface::putInJSON<double>(response_json, doubleMonitorable);
 
     response_json.put_child("utilization", utilization);
+    response_json.put_child("latency", latency);
+    response_json.put_child("load", load);
     json_response = true;
 
     return true;
@@ -322,6 +426,12 @@ bool HTTPInterface::epExecute(const std::string& arg){
 
         response_json.put("server_number", server_request_status);
         response_json.put("dimmer_factor", dimmer_request_status);
+
+        // admission rate is optional, so that existing clients keep working
+        auto admission_request = json_request.get_optional<std::string>("admission_rate");
+        if (admission_request) {
+            response_json.put("admission_rate", HTTPInterface::cmdSetAdmissionRate(*admission_request));
+        }
     } catch (boost::property_tree::ptree_bad_path& e) {
         response_json.put("error", std::string("Missing key in request: ") + e.what());
         HTTPInterface::sendJSONResponse(BAD_REQUEST,response_json);
@@ -334,6 +444,79 @@ bool HTTPInterface::epExecute(const std::string& arg){
     return true;
 }
 
+bool HTTPInterface::epForecast(const std::string& arg){
+    if (!forecast.isAvailable()) {
+        response_json.put("error", "The source does not predict its arrivals");
+        HTTPInterface::sendJSONResponse(BAD_REQUEST,response_json);
+
+        return false;
+    }
+
+    std::map<std::string, std::string> query = parseQuery();
+    double start = 0;
+    double window = pModel->getEvaluationPeriod();
+    int steps = 1;
+    double noise = -1;
+    bool valid = true;
+    try {
+        if (query.count("start")) { start = std::stod(query["start"]); }
+        if (query.count("window")) { window = std::stod(query["window"]); }
+        if (query.count("steps")) { steps = std::stoi(query["steps"]); }
+        if (query.count("noise")) { noise = std::stod(query["noise"]); }
+    } catch (const std::logic_error& e) {
+        valid = false;
+    }
+
+    if (!valid || start < 0 || window <= 0 || steps < 1) {
+        response_json.put("error", "Invalid start, window or steps parameter");
+        HTTPInterface::sendJSONResponse(BAD_REQUEST,response_json);
+
+        return false;
+    }
+
+    if (steps > (int) SourceForecast::MAX_WINDOWS) {
+        response_json.put("error", "At most " + std::to_string(SourceForecast::MAX_WINDOWS) + " steps");
+        HTTPInterface::sendJSONResponse(BAD_REQUEST,response_json);
+
+        return false;
+    }
+
+    std::vector<SourceForecast::Window> windows;
+    forecast.get(start, window, steps, noise, windows);
+
+    boost::property_tree::ptree window_array_ptree;
+    for (const SourceForecast::Window& w : windows) {
+        boost::property_tree::ptree window_ptree;
+        window_ptree.put("start", w.start);
+        window_ptree.put("mean_interarrival", w.meanInterArrival);
+        window_ptree.put("variance", w.variance);
+
+        window_array_ptree.push_back(std::make_pair("", window_ptree));
+    }
+
+    response_json.put("start", start);
+    response_json.put("window", window);
+    response_json.put_child("forecast", window_array_ptree);
+    json_response = true;
+
+    return true;
+}
+
+std::map<std::string, std::string> HTTPInterface::parseQuery() const {
+    std::map<std::string, std::string> query;
+    std::istringstream query_stream(http_rq_query);
+    for (std::string param; std::getline(query_stream, param, '&');) {
+        size_t equal_pos = param.find('=');
+        if (equal_pos != std::string::npos) {
+            query[param.substr(0, equal_pos)] = param.substr(equal_pos + 1);
+        } else if (!param.empty()) {
+            query[param] = "";
+        }
+    }
+
+    return query;
+}
+
 std::string HTTPInterface::cmdSetServers(const std::string& arg){
     ExecutionManagerModBase* pExecMgr = check_and_cast<ExecutionManagerModBase*> (getParentModule()->getSubmodule("executionManager"));
     
@@ -377,3 +560,18 @@ std::string HTTPInterface::cmdSetDimmer(const std::string& arg){
 
     return COMMAND_SUCCESS;
 }
+
+std::string HTTPInterface::cmdSetAdmissionRate(const std::string& arg){
+    if (arg == ""){
+        return "\"error: missing admission rate argument\"";
+    }
+
+    double rate = atof(arg.c_str());
+    if (rate < 0) {
+        return "error: admission rate must be >= 0";
+    }
+    ExecutionManagerModBase* pExecMgr = check_and_cast<ExecutionManagerModBase*> (getParentModule()->getSubmodule("executionManager"));
+    pExecMgr->setAdmissionRate(rate);
+
+    return COMMAND_SUCCESS;
+}
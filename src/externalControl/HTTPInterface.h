@@ -24,6 +24,7 @@
 #include <map>
 #include "model/Model.h"
 #include "managers/monitor/IProbe.h"
+#include "SourceForecast.h"
 #include <boost/tokenizer.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -45,6 +46,7 @@ protected:
     std::map<std::string, std::map<std::string, std::function<bool(const std::string&)>> > HTTPAPI;
     Model* pModel;
     IProbe* pProbe;
+    SourceForecast forecast;
 
     virtual void initialize();
     virtual void handleMessage(cMessage *msg);
@@ -54,8 +56,11 @@ protected:
     virtual void updateMonitoring();
     virtual std::string cmdSetServers(const std::string& arg);
     virtual std::string cmdSetDimmer(const std::string& arg);
+    virtual std::string cmdSetAdmissionRate(const std::string& arg);
 
     boost::property_tree::ptree allUtilization();
+    boost::property_tree::ptree allLatency();
+    boost::property_tree::ptree allLoad();
 
     template <class T>
     void putInJSON(boost::property_tree::ptree& json_file, std::map<std::string, T*>& some_map);
@@ -68,6 +73,20 @@ protected:
     virtual bool epAdapOptSchema(const std::string& arg);
     virtual bool epExecute(const std::string& arg);
 
+    /**
+     * Forecast of the arrivals for the windows given by the start, window
+     * and steps query parameters, with optional noise (see SourceForecast)
+     *
+     * Requests for more than SourceForecast::MAX_WINDOWS steps, or with
+     * numbers that cannot be parsed (or are out of range), get a 400
+     */
+    virtual bool epForecast(const std::string& arg);
+
+    /**
+     * Parses the query string of the request into its parameters
+     */
+    std::map<std::string, std::string> parseQuery() const;
+
 private:
     static const unsigned BUFFER_SIZE = 4000;
     cMessage *rtEvent;
@@ -76,6 +95,7 @@ private:
     std::string http_rq_type;
     std::string http_rq_body;
     std::string http_rq_endpoint;
+    std::string http_rq_query;
     std::vector<std::string> lines;
     std::string response_body;
     std::string status_code;
@@ -90,7 +110,28 @@ private:
     double opt_throughput;
     double opt_rt;
     double arrival_rate;
+    double admission_rate;
+    double rejected_rate;
+    double timed_out_rate;
+    double basic_rt_p50;
+    double basic_rt_p95;
+    double basic_rt_p99;
+    double opt_rt_p50;
+    double opt_rt_p95;
+    double opt_rt_p99;
+    double basic_queue_time;
+    double basic_service_time;
+    double basic_slowdown;
+    double opt_queue_time;
+    double opt_service_time;
+    double opt_slowdown;
+    int queue_length;
+    int running_jobs;
+    int timed_out_count;
+    int rejected_count;
     boost::property_tree::ptree utilization;
+    boost::property_tree::ptree latency;
+    boost::property_tree::ptree load;
 
     char recvBuffer[BUFFER_SIZE];
     int numRecvBytes;
@@ -110,12 +151,34 @@ private:
       "basic_throughput",
       "opt_rt",
       "opt_throughput",
-      "arrival_rate"
+      "arrival_rate",
+      "admission_rate",
+      "rejected_rate",
+      "timed_out_rate",
+      "basic_rt_p50",
+      "basic_rt_p95",
+      "basic_rt_p99",
+      "opt_rt_p50",
+      "opt_rt_p95",
+      "opt_rt_p99",
+      "basic_queue_time",
+      "basic_service_time",
+      "basic_slowdown",
+      "opt_queue_time",
+      "opt_service_time",
+      "opt_slowdown",
+      "latency",
+      "queue_length",
+      "running_jobs",
+      "timed_out_count",
+      "rejected_count",
+      "load"
     };
 
     std::vector<std::string> adaptations = {
       "server_number",
-      "dimmer_factor"
+      "dimmer_factor",
+      "admission_rate"
     };
 };
 
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+#include "SourceForecast.h"
+#include <algorithm>
+#include <cmath>
+#include <modules/PredictableSource.h>
+
+using namespace omnetpp;
+
+namespace {
+    const int FORECAST_RNG = 6;
+}
+
+SourceForecast::SourceForecast() : pInterface(nullptr), pSource(nullptr), defaultNoise(0) {
+}
+
+void SourceForecast::initialize(cSimpleModule* pInterface) {
+    this->pInterface = pInterface;
+    pSource = dynamic_cast<PredictableSource*>(pInterface->getParentModule()->getSubmodule("source"));
+    defaultNoise = pInterface->par("forecastNoise");
+}
+
+bool SourceForecast::isAvailable() const {
+    return pSource != nullptr;
+}
+
+void SourceForecast::get(double start, double windowDuration, unsigned windows, double noise,
+        std::vector<Window>& forecast) {
+    ASSERT(pSource != nullptr);
+    if (noise < 0) {
+        noise = defaultNoise;
+    }
+
+    std::vector<double> means;
+    std::vector<double> moments;
+    pSource->getPredictions(start, windowDuration, windows, means, &moments);
+
+    // lognormal with mean 1 and coefficient of variation noise
+    double sigma = std::sqrt(std::log(1 + noise * noise));
+
+    forecast.resize(windows);
+    for (unsigned w = 0; w < windows; w++) {
+        Window& window = forecast[w];
+        window.start = start + w * windowDuration;
+
+        // the source predicts the second moment about zero
+        window.meanInterArrival = means[w];
+        window.variance = std::max(0.0, moments[w] - means[w] * means[w]);
+        if (sigma > 0) {
+            double factor = std::exp(pInterface->normal(-sigma * sigma / 2, sigma, FORECAST_RNG));
+            window.meanInterArrival *= factor;
+            window.variance *= factor * factor;
+        }
+    }
+}
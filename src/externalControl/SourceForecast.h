@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_SOURCEFORECAST_H_
+#define __PLASA_SOURCEFORECAST_H_
+
+#include <omnetpp.h>
+#include <vector>
+
+class PredictableSource;
+
+/**
+ * Forecast of the arrivals for external adaptation managers
+ *
+ * The forecast is the prediction of the source (see
+ * PredictableSource::getPredictions()), so it is exact unless noise is added.
+ * The noise emulates the error of a real forecaster: the interarrival times
+ * of each window are scaled by an independent lognormal factor with mean 1
+ * and the given coefficient of variation.
+ */
+class SourceForecast {
+    omnetpp::cComponent* pInterface;
+    PredictableSource* pSource;
+    double defaultNoise;
+
+public:
+    /** most windows a forecast can have, which bounds the work of a request */
+    static const unsigned MAX_WINDOWS = 1000;
+
+    struct Window {
+        double start; /**< start of the window relative to now */
+        double meanInterArrival;
+        double variance; /**< variance of the interarrival time */
+    };
+
+    SourceForecast();
+
+    /**
+     * @param pInterface interface module, sibling of the source, with the
+     *   forecastNoise parameter
+     */
+    void initialize(omnetpp::cSimpleModule* pInterface);
+
+    /**
+     * @return false if the source cannot predict its arrivals
+     */
+    bool isAvailable() const;
+
+    /**
+     * Computes the forecast for consecutive windows
+     *
+     * @param start start of the first window relative to now
+     * @param noise coefficient of variation of the error, or negative to use
+     *   the forecastNoise parameter
+     */
+    void get(double start, double windowDuration, unsigned windows, double noise,
+            std::vector<Window>& forecast);
+};
+
+#endif
@@ -20,6 +20,29 @@
 
 const char* UtilityScorer::OPT_REVENUE = "optRevenue";
 const char* UtilityScorer::PENALTY_MULTIPLIER = "penaltyMultiplier";
+const char* UtilityScorer::RT_PERCENTILE = "responseTimePercentile";
+
+double UtilityScorer::getScoredResponseTime(const Observations& observations)
+{
+    const auto& sysmodule = omnetpp::getSimulation()->getSystemModule();
+    if (!sysmodule->hasPar(RT_PERCENTILE)) {
+        return observations.avgResponseTime;
+    }
+
+    int percentile = sysmodule->par(RT_PERCENTILE);
+    switch (percentile) {
+    case 0:
+        return observations.avgResponseTime;
+    case 50:
+        return observations.responseTimePercentiles.p50;
+    case 95:
+        return observations.responseTimePercentiles.p95;
+    case 99:
+        return observations.responseTimePercentiles.p99;
+    default:
+        throw omnetpp::cRuntimeError("%s must be 0, 50, 95 or 99", RT_PERCENTILE);
+    }
+}
 
 /**
  * returns utility per unit of time;
@@ -49,7 +72,8 @@ double UtilityScorer::getAccruedUtility(const Model& model, const Configuration&
 
     double positiveUtility = round((throughput * (brownoutFactor * brownoutRevenue + (1 - brownoutFactor) * normalRevenue)));
 
-    double utility = ((observations.avgResponseTime>RT_THRESHOLD || observations.avgResponseTime < 0) ? std::min(0.0, throughput * normalRevenue - latePenalty) : positiveUtility);
+    double responseTime = getScoredResponseTime(observations);
+    double utility = ((responseTime>RT_THRESHOLD || responseTime < 0) ? std::min(0.0, throughput * normalRevenue - latePenalty) : positiveUtility);
 
     return utility / model.getEvaluationPeriod();
 }
@@ -33,6 +33,13 @@ protected:
 
     static const char* OPT_REVENUE;
     static const char* PENALTY_MULTIPLIER;
+    static const char* RT_PERCENTILE;
+
+    /**
+     * Returns the response time compared with the threshold: the mean, or
+     * the percentile set in the responseTimePercentile parameter (if > 0)
+     */
+    static double getScoredResponseTime(const Observations& observations);
 
 public:
 
@@ -27,5 +27,6 @@
 #include "RemoveServerTactic.h"
 #include "SetBrownoutTactic.h"
 #include "SetDimmerTactic.h"
+#include "SetAdmissionRateTactic.h"
 
 #endif /* ALLTACTICS_H_ */
@@ -20,6 +20,16 @@ public:
     virtual void addServer() = 0;
     virtual void removeServer() = 0;
     virtual void setBrownout(double factor) = 0;
+
+    /**
+     * Sets the brownout factor of the requests of one class (see RequestClass)
+     */
+    virtual void setClassBrownout(unsigned requestClass, double factor) = 0;
+
+    /**
+     * @param rate max requests per second admitted (0 for no limit)
+     */
+    virtual void setAdmissionRate(double rate) = 0;
     virtual ~ExecutionManager() {}
 };
 
@@ -15,6 +15,7 @@
 #include "ExecutionManagerHAProxy.h"
 
 #include <sstream>
+#include <cmath>
 #include <util/Utils.h>
 
 using namespace std;
@@ -104,3 +105,13 @@ void ExecutionManagerHAProxy::doSetBrownout(double factor) {
     cmd << '\n';
     loadBalancer.executeCommand(cmd.str());
 }
+
+void ExecutionManagerHAProxy::doSetAdmissionRate(double rate) {
+
+    // HAProxy limits the rate of new sessions per second (0 means no limit)
+    ostringstream cmd;
+    cmd << "set rate-limit sessions global ";
+    cmd << (int) round(rate);
+    cmd << '\n';
+    loadBalancer.executeCommand(cmd.str());
+}
@@ -44,6 +44,7 @@ class ExecutionManagerHAProxy : public ExecutionManagerModBase
      */
     virtual BootComplete* doRemoveServer();
     virtual void doSetBrownout(double factor);
+    virtual void doSetAdmissionRate(double rate);
 };
 
 #endif
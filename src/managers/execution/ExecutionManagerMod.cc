@@ -16,9 +16,12 @@
 #include <sstream>
 #include <boost/tokenizer.hpp>
 #include <cstdlib>
-#include "PassiveQueue.h"
+#include "modules/ServerQueue.h"
 #include "modules/MTServer.h"
 #include "modules/MTBrownoutServer.h"
+#include "modules/CentralQueue.h"
+#include "modules/LoadBalancer.h"
+#include "modules/RequestClass.h"
 #include <util/Utils.h>
 
 
@@ -64,8 +67,15 @@ void ExecutionManagerMod::doAddServerBootComplete(BootComplete* bootComplete) {
             LOAD_BALANCER_MODULE_NAME);
     cModule* sink = getParentModule()->getSubmodule(SINK_MODULE_NAME);
     // connect gates
-    loadBalancer->getOrCreateFirstUnconnectedGate("out", 0, false, true)->connectTo(
-            server->gate("in"));
+    cGate* pOutGate = loadBalancer->getOrCreateFirstUnconnectedGate("out", 0, false, true);
+    pOutGate->connectTo(server->gate("in"));
+    serverRegistry.add(pOutGate->getIndex(), server);
+
+    // with a central queue, the new server has to pull jobs that are already waiting
+    CentralQueue* pCentralQueue = dynamic_cast<CentralQueue*>(loadBalancer);
+    if (pCentralQueue) {
+        pCentralQueue->serverAttached(pOutGate->getIndex());
+    }
     server->gate("out")->connectTo(
             sink->getOrCreateFirstUnconnectedGate("in", 0, false, true));
 }
@@ -74,6 +84,10 @@ void ExecutionManagerMod::doAddServerBootComplete(BootComplete* bootComplete) {
 ExecutionManagerMod::~ExecutionManagerMod() {
 }
 
+const ServerRegistry& ExecutionManagerMod::getServerRegistry() const {
+    return serverRegistry;
+}
+
 
 BootComplete* ExecutionManagerMod::doAddServer(bool instantaneous) {
     // find factory object
@@ -105,10 +119,19 @@ BootComplete* ExecutionManagerMod::doAddServer(bool instantaneous) {
         // if it's the first server, we need to set the parameters common to all servers in the model
         pModel->setServerThreads(pNewSubmodule->par("threads"));
         double variance = 0.0;
-        double mean = Utils::getMeanAndVarianceFromParameter(pNewSubmodule->par("serviceTime"), &variance);
-        pModel->setServiceTime(mean, variance);
-        mean = Utils::getMeanAndVarianceFromParameter(pNewSubmodule->par("lowFidelityServiceTime"), &variance);
-        pModel->setLowFidelityServiceTime(mean, variance);
+        if (RequestClass::getCount() > 0) {
+
+            // the requests are served with the service times of their classes
+            double mean = RequestClass::getMixServiceTime(false, &variance);
+            pModel->setServiceTime(mean, variance);
+            mean = RequestClass::getMixServiceTime(true, &variance);
+            pModel->setLowFidelityServiceTime(mean, variance);
+        } else {
+            double mean = Utils::getMeanAndVarianceFromParameter(pNewSubmodule->par("serviceTime"), &variance);
+            pModel->setServiceTime(mean, variance);
+            mean = Utils::getMeanAndVarianceFromParameter(pNewSubmodule->par("lowFidelityServiceTime"), &variance);
+            pModel->setLowFidelityServiceTime(mean, variance);
+        }
         pModel->setBrownoutFactor(pNewSubmodule->par("brownoutFactor"));
     }
 
@@ -140,6 +163,7 @@ BootComplete*  ExecutionManagerMod::doRemoveServer() {
         otherEnd->getOwnerModule()->setGateSize(otherEnd->getName(), otherEnd->getVectorSize() - 1);
         //TODO this is probably leaking memory because the gate may not be being deleted
     }
+    serverRegistry.remove(module->getId());
 
     // this will signal iProbe so that the entry that monitors this server is removed
     notifyRemoveServerCompleted(module->getName());
@@ -178,6 +202,34 @@ void ExecutionManagerMod::doSetBrownout(double factor) {
         cModule* module = getSimulation()->getModule(moduleId);
         module->getSubmodule("server")->par("brownoutFactor").setDoubleValue(factor);
     }
+
+    // the factor applies to all the request classes
+    unsigned classCount = RequestClass::getCount();
+    for (unsigned c = 0; c < classCount; c++) {
+        RequestClass::get(c)->setBrownoutFactor(factor);
+    }
+}
+
+void ExecutionManagerMod::doSetClassBrownout(unsigned requestClass, double factor) {
+    RequestClass* pClass = RequestClass::get(requestClass);
+    if (pClass == nullptr) {
+        error("request class %u does not exist", requestClass);
+    }
+    pClass->setBrownoutFactor(factor);
+}
+
+
+void ExecutionManagerMod::doSetAdmissionRate(double rate) {
+    cModule* loadBalancer = getParentModule()->getSubmodule(LOAD_BALANCER_MODULE_NAME);
+    LoadBalancer* pLoadBalancer = dynamic_cast<LoadBalancer*>(loadBalancer);
+    CentralQueue* pCentralQueue = dynamic_cast<CentralQueue*>(loadBalancer);
+    if (pLoadBalancer) {
+        pLoadBalancer->setAdmissionRate(rate);
+    } else if (pCentralQueue) {
+        pCentralQueue->setAdmissionRate(rate);
+    } else {
+        error("load balancer does not support admission control");
+    }
 }
 
 
@@ -199,8 +251,8 @@ bool ExecutionManagerMod::isServerBeingRemoveEmpty(int serverBeingRemovedModuleI
     cModule* module = getSimulation()->getModule(serverBeingRemovedModuleId);
     MTServer* internalServer = check_and_cast<MTServer*> (module->getSubmodule(INTERNAL_SERVER_MODULE_NAME));
     if (internalServer->isEmpty()) {
-        queueing::PassiveQueue* queue = check_and_cast<queueing::PassiveQueue*> (module->getSubmodule(INTERNAL_QUEUE_MODULE_NAME));
-        if (queue->length() == 0) {
+        ServerQueue* queue = check_and_cast<ServerQueue*> (module->getSubmodule(INTERNAL_QUEUE_MODULE_NAME));
+        if (queue->length() == 0 && queue->getExpectedJobCount() == 0) {
             isEmpty = true;
         }
     }
@@ -21,10 +21,12 @@
 #include "RemoveComplete_m.h"
 #include <model/Model.h>
 #include "ExecutionManagerModBase.h"
+#include <modules/ServerRegistry.h>
 
 class ExecutionManagerMod : public ExecutionManagerModBase, omnetpp::cListener {
     omnetpp::simsignal_t serverBusySignalId;
     std::set<int> serversBeingRemoved;
+    ServerRegistry serverRegistry;
 
     /**
      * Sends a message so that when received (immediately) will complete the removal
@@ -52,11 +54,18 @@ class ExecutionManagerMod : public ExecutionManagerModBase, omnetpp::cListener {
      */
     virtual BootComplete* doRemoveServer();
     virtual void doSetBrownout(double factor);
+    virtual void doSetAdmissionRate(double rate);
+    virtual void doSetClassBrownout(unsigned requestClass, double factor);
 
   public:
     ExecutionManagerMod();
     virtual ~ExecutionManagerMod();
 
+    /**
+     * @return registry of the active servers, indexed by load balancer out gate
+     */
+    const ServerRegistry& getServerRegistry() const;
+
     virtual void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, bool value, cObject *details) override;
 };
 
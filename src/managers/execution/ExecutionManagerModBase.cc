@@ -24,6 +24,7 @@ const char* ExecutionManagerModBase::SIG_SERVER_REMOVED = "serverRemoved";
 const char* ExecutionManagerModBase::SIG_SERVER_ADDED = "serverAdded";
 const char* ExecutionManagerModBase::SIG_SERVER_ACTIVATED = "serverActivated";
 const char* ExecutionManagerModBase::SIG_BROWNOUT_SET = "brownoutSet";
+const char* ExecutionManagerModBase::SIG_ADMISSION_RATE_SET = "admissionRateSet";
 
 
 ExecutionManagerModBase::ExecutionManagerModBase() : testMsg(0) {
@@ -35,6 +36,7 @@ void ExecutionManagerModBase::initialize() {
     serverAddedSignal = registerSignal(SIG_SERVER_ADDED);
     serverActivatedSignal = registerSignal(SIG_SERVER_ACTIVATED);
     brownoutSetSignal = registerSignal(SIG_BROWNOUT_SET);
+    admissionRateSetSignal = registerSignal(SIG_ADMISSION_RATE_SET);
 //    testMsg = new cMessage;
 //    testMsg->setKind(0);
 //    scheduleAt(simTime() + 1, testMsg);
@@ -134,6 +136,26 @@ void ExecutionManagerModBase::setBrownout(double factor) {
     emit(brownoutSetSignal, true);
 }
 
+void ExecutionManagerModBase::setClassBrownout(unsigned requestClass, double factor) {
+    Enter_Method("setClassBrownout()");
+    cout << "t=" << simTime() << " executing setClassDimmer(" << requestClass << ", " << 1.0 - factor << ")" << endl;
+    pModel->setClassBrownoutFactor(requestClass, factor);
+    doSetClassBrownout(requestClass, factor);
+    emit(brownoutSetSignal, true);
+}
+
+void ExecutionManagerModBase::doSetClassBrownout(unsigned requestClass, double factor) {
+    error("execution manager does not support request classes");
+}
+
+void ExecutionManagerModBase::setAdmissionRate(double rate) {
+    Enter_Method("setAdmissionRate()");
+    cout << "t=" << simTime() << " executing setAdmissionRate(" << rate << ")" << endl;
+    pModel->setAdmissionRate(rate);
+    doSetAdmissionRate(rate);
+    emit(admissionRateSetSignal, true);
+}
+
 void ExecutionManagerModBase::notifyRemoveServerCompleted(const char* serverId) {
 
     // emit signal to notify others (notably iProbe)
@@ -26,6 +26,7 @@ class ExecutionManagerModBase : public omnetpp::cSimpleModule, public ExecutionM
     omnetpp::simsignal_t serverAddedSignal;
     omnetpp::simsignal_t serverActivatedSignal;
     omnetpp::simsignal_t brownoutSetSignal;
+    omnetpp::simsignal_t admissionRateSetSignal;
 
   protected:
     typedef std::set<BootComplete*> BootCompletes;
@@ -63,12 +64,19 @@ class ExecutionManagerModBase : public omnetpp::cSimpleModule, public ExecutionM
      */
     virtual BootComplete* doRemoveServer() = 0;
     virtual void doSetBrownout(double factor) = 0;
+    virtual void doSetAdmissionRate(double rate) = 0;
+
+    /**
+     * Only needed if the target has request classes
+     */
+    virtual void doSetClassBrownout(unsigned requestClass, double factor);
 
   public:
     static const char* SIG_SERVER_REMOVED;
     static const char* SIG_SERVER_ADDED;
     static const char* SIG_SERVER_ACTIVATED;
     static const char* SIG_BROWNOUT_SET;
+    static const char* SIG_ADMISSION_RATE_SET;
 
     ExecutionManagerModBase();
     virtual ~ExecutionManagerModBase();
@@ -78,6 +86,8 @@ class ExecutionManagerModBase : public omnetpp::cSimpleModule, public ExecutionM
     virtual void addServer();
     virtual void removeServer();
     virtual void setBrownout(double factor);
+    virtual void setClassBrownout(unsigned requestClass, double factor);
+    virtual void setAdmissionRate(double rate);
 };
 
 #endif /* EXECUTIONMANAGERMODBASE_H_ */
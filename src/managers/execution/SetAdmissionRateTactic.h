@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef SETADMISSIONRATETACTIC_H_
+#define SETADMISSIONRATETACTIC_H_
+
+#include "Tactic.h"
+
+class SetAdmissionRateTactic: public Tactic {
+    double rate;
+public:
+    SetAdmissionRateTactic(double rate);
+    virtual void execute(ExecutionManager* execMgr);
+    virtual void printOn(std::ostream& os) const;
+    virtual ~SetAdmissionRateTactic();
+};
+
+#endif /* SETADMISSIONRATETACTIC_H_ */
@@ -0,0 +1,31 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "SetClassDimmerTactic.h"
+
+SetClassDimmerTactic::SetClassDimmerTactic(unsigned requestClass, double factor)
+    : requestClass(requestClass), factor(factor) {
+}
+
+void SetClassDimmerTactic::execute(ExecutionManager* execMgr) {
+    execMgr->setClassBrownout(requestClass, 1.0 - factor);
+}
+
+void SetClassDimmerTactic::printOn(std::ostream& os) const {
+    os << "SetClassDimmer(" << requestClass << ", " << factor << ")";
+}
+
+SetClassDimmerTactic::~SetClassDimmerTactic() {
+}
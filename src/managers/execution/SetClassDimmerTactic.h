@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef SETCLASSDIMMERTACTIC_H_
+#define SETCLASSDIMMERTACTIC_H_
+
+#include "Tactic.h"
+
+/**
+ * Sets the dimmer of the requests of one request class
+ */
+class SetClassDimmerTactic: public Tactic {
+    unsigned requestClass;
+    double factor;
+public:
+    SetClassDimmerTactic(unsigned requestClass, double factor);
+    virtual void execute(ExecutionManager* execMgr);
+    virtual void printOn(std::ostream& os) const;
+    virtual ~SetClassDimmerTactic();
+};
+
+#endif /* SETCLASSDIMMERTACTIC_H_ */
@@ -14,6 +14,8 @@
  *******************************************************************************/
 #include "HAProxyProbe.h"
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include "managers/ModulePriorities.h"
 #include <managers/execution/ExecutionManagerModBase.h>
 
@@ -104,7 +106,7 @@ Environment HAProxyProbe::getUpdatedEnvironment() {
         double measuredMeanInterArrival = (arrivalRate > 0) ? (1 / arrivalRate) : 0;
 
         environment.setArrivalMean(measuredMeanInterArrival);
-        environment.setArrivalVariance(pow(measuredMeanInterArrival, 2)); // assume exponential distribution
+        environment.setArrivalVariance(pow(measuredMeanInterArrival, 2)); // assume exponential distribution (HAProxy only reports counters)
     }
 
     return environment;
@@ -166,6 +168,141 @@ double HAProxyProbe::getArrivalRate() {
     return rate;
 }
 
+/*
+ * The LogFileProbe does not report rejected and timed out requests, so these
+ * rates are derived from the counters in HAProxy's stats (see updateLoad())
+ */
+double HAProxyProbe::getRejectedRate() {
+    updateLoad();
+    return observations.rejectedRate;
+}
+
+double HAProxyProbe::getTimedOutRate() {
+    updateLoad();
+    return observations.timedOutRate;
+}
+
+/*
+ * The LogFileProbe only reports mean response times, so percentiles are not
+ * available
+ */
+double HAProxyProbe::getBasicResponseTimePercentile(double percentile) {
+    return 0.0;
+}
+
+double HAProxyProbe::getOptResponseTimePercentile(double percentile) {
+    return 0.0;
+}
+
+/*
+ * The breakdown of the response time is not available either
+ */
+Observations::LatencyBreakdown HAProxyProbe::getLatencyBreakdown(const std::string& serverName, bool basic) {
+    return Observations::LatencyBreakdown();
+}
+
+Observations::LoadGauges HAProxyProbe::getLoadGauges(const std::string& serverName) {
+    updateLoad();
+    if (serverName.empty()) {
+        return observations.load;
+    }
+
+    auto it = serverLoad.find(serverName);
+    if (it != serverLoad.end()) {
+        return it->second;
+    }
+
+    return Observations::LoadGauges(); // server not found
+}
+
+Observations::ClassObservations HAProxyProbe::getClassObservations(unsigned requestClass) {
+    return Observations::ClassObservations(); // HAProxy does not tell request classes apart
+}
+
+/*
+ * The gauges are taken from the CSV output of "show stat" (columns start with idx 0):
+ *  1. svname: FRONTEND, BACKEND, or the server name
+ *  2. qcur: current queued requests (in the backend, or for a server)
+ *  4. scur: current sessions (i.e., requests being served by the server)
+ * 10. dreq: requests denied by the frontend (used for rejected)
+ * 14. eresp: response errors, which include the requests aborted by the
+ *     server timeout (used for timed out)
+ * 28. sid: server id, which is the number of the server
+ */
+void HAProxyProbe::updateLoad() {
+
+    // update only if not stale
+    auto currentTime = boost::posix_time::microsec_clock::local_time();
+    if (!lastLoadUpdate.is_not_a_date_time()
+            && (currentTime - lastLoadUpdate).total_milliseconds()
+                    <= MEASUREMENT_OBSOLECENSE_MSEC) {
+        return;
+    }
+    bool firstUpdate = lastLoadUpdate.is_not_a_date_time();
+    lastLoadUpdate = currentTime;
+
+    // -1 7 -1: all proxies, frontends + backends + servers
+    string reply = loadBalancer.executeCommand("show stat -1 7 -1\n");
+
+    observations.load = Observations::LoadGauges();
+    serverLoad.clear();
+    int activeServers = pModel->getActiveServers();
+    stringstream replyStream(reply);
+    string line;
+    while (getline(replyStream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue; // header
+        }
+
+        vector<string> columns;
+        stringstream lineStream(line);
+        string column;
+        while (getline(lineStream, column, ',')) {
+            columns.push_back(column);
+        }
+        if (columns.size() <= 28) {
+            continue;
+        }
+
+        const string& svname = columns[1];
+        if (svname == "FRONTEND") {
+            observations.load.rejected += atol(columns[10].c_str());
+        } else if (svname == "BACKEND") {
+            observations.load.queueLength += atol(columns[2].c_str());
+            observations.load.timedOut += atol(columns[14].c_str());
+        } else {
+            int serverNumber = atoi(columns[28].c_str());
+            if (serverNumber < 1 || serverNumber > activeServers) {
+                continue; // not active
+            }
+            stringstream serverId;
+            serverId << "server";
+            serverId << serverNumber;
+            Observations::LoadGauges& load = serverLoad[serverId.str()];
+            load.queueLength = atol(columns[2].c_str());
+            load.runningJobs = atol(columns[4].c_str());
+            load.timedOut = atol(columns[14].c_str());
+            observations.load.queueLength += load.queueLength;
+            observations.load.runningJobs += load.runningJobs;
+        }
+    }
+
+    /*
+     * The counters are cumulative (they restart if HAProxy is reloaded), so
+     * their increments are recorded, and the rate is the sum of the
+     * increments in the window over the time it covers, that is, the
+     * average increment times the rate of the updates
+     */
+    if (!firstUpdate) {
+        rejectedIncrements.record(max(0L, observations.load.rejected - lastRejected));
+        timedOutIncrements.record(max(0L, observations.load.timedOut - lastTimedOut));
+    }
+    lastRejected = observations.load.rejected;
+    lastTimedOut = observations.load.timedOut;
+    observations.rejectedRate = rejectedIncrements.getAverage() * rejectedIncrements.getRate();
+    observations.timedOutRate = timedOutIncrements.getAverage() * timedOutIncrements.getRate();
+}
+
 HAProxyProbe::~HAProxyProbe() {
     cancelAndDelete(initEvent);
     cancelAndDelete(endWarmupEvent);
@@ -201,6 +338,10 @@ void HAProxyProbe::initialize(int stage) {
 
         loadBalancer.setAddress(par("HAProxySocketPath").stringValue());
         lastRequestCounter = 0;
+        lastRejected = 0;
+        lastTimedOut = 0;
+        rejectedIncrements.setWindow((unsigned) pModel->getEvaluationPeriod());
+        timedOutIncrements.setWindow((unsigned) pModel->getEvaluationPeriod());
 
         // connect to the logfileprobe
         cout << "Connecting to LogFileProbe...";
@@ -294,5 +435,9 @@ void HAProxyProbe::receiveSignal(cComponent *source, simsignal_t signalID, const
         if (it != utilization.end()) {
             utilization.erase(it);
         }
+        auto loadIt = serverLoad.find(value);
+        if (loadIt != serverLoad.end()) {
+            serverLoad.erase(loadIt);
+        }
     }
 }
@@ -18,6 +18,7 @@
 #include <boost/asio.hpp>
 #include "IProbe.h"
 #include "util/HAProxySocketCommand.h"
+#include "util/TimeWindowStats.h"
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include <map>
 #include <string>
@@ -42,9 +43,20 @@ class HAProxyProbe : public IProbe, omnetpp::cListener
 
     boost::posix_time::ptime lastEnvironmentUpdate;
     boost::posix_time::ptime lastObservationsUpdate;
+    boost::posix_time::ptime lastLoadUpdate;
+    long lastRejected; /**< counter at lastLoadUpdate, for the rate */
+    long lastTimedOut; /**< counter at lastLoadUpdate, for the rate */
+
+    /**
+     * Increments of the rejected and timed out counters in the last
+     * evaluation period (in real time, since they come from HAProxy)
+     */
+    RealTimeWindowStats rejectedIncrements;
+    RealTimeWindowStats timedOutIncrements;
     Environment environment;
     Observations observations;
     std::map<std::string, double> utilization;
+    std::map<std::string, Observations::LoadGauges> serverLoad;
 
     Model* pModel;
 
@@ -59,10 +71,23 @@ class HAProxyProbe : public IProbe, omnetpp::cListener
     double getOptThroughput();
     double getUtilization(const std::string& serverName);
     double getArrivalRate();
+    double getRejectedRate();
+    double getTimedOutRate();
+    double getBasicResponseTimePercentile(double percentile);
+    double getOptResponseTimePercentile(double percentile);
+    Observations::LatencyBreakdown getLatencyBreakdown(const std::string& serverName, bool basic);
+    Observations::LoadGauges getLoadGauges(const std::string& serverName);
+    Observations::ClassObservations getClassObservations(unsigned requestClass);
 
     Observations getUpdatedObservations();
     Environment getUpdatedEnvironment();
 
+    /**
+     * Updates observations.load, serverLoad, and the rejected and timed out
+     * rates from HAProxy's stats
+     */
+    void updateLoad();
+
     void connectToLogFileProbe();
     void sendReplayTraceSyncSignal();
 
@@ -32,6 +32,49 @@ public:
     virtual double getUtilization(const std::string& serverName) = 0;
     virtual double getArrivalRate() = 0;
 
+    /**
+     * @return requests per second rejected by admission control or because queues were full
+     */
+    virtual double getRejectedRate() = 0;
+
+    /**
+     * @return requests per second that timed out waiting and were not served
+     */
+    virtual double getTimedOutRate() = 0;
+
+    /**
+     * @param percentile in [0, 100]
+     * @return response time percentile of requests served without optional content
+     */
+    virtual double getBasicResponseTimePercentile(double percentile) = 0;
+
+    /**
+     * @param percentile in [0, 100]
+     * @return response time percentile of requests served with optional content
+     */
+    virtual double getOptResponseTimePercentile(double percentile) = 0;
+
+    /**
+     * @param serverName server, or empty for all the servers
+     * @param basic true for requests served without optional content
+     * @return breakdown of the time requests spent in the server(s)
+     */
+    virtual Observations::LatencyBreakdown getLatencyBreakdown(const std::string& serverName, bool basic) = 0;
+
+    /**
+     * @param serverName server, or empty for all the servers
+     * @return current queue length and running jobs, and the requests that
+     *   timed out or were rejected so far
+     */
+    virtual Observations::LoadGauges getLoadGauges(const std::string& serverName) = 0;
+
+    /**
+     * @param requestClass index of the request class (see RequestClass)
+     * @return statistics of the requests of the class (all 0 if the class
+     *   does not exist or the target does not distinguish classes)
+     */
+    virtual Observations::ClassObservations getClassObservations(unsigned requestClass) = 0;
+
     /**
      * Computes the statistics of observations
      *
@@ -15,6 +15,11 @@
 #include "SimProbe.h"
 #include <model/Model.h>
 #include <managers/execution/ExecutionManagerModBase.h>
+#include <util/BucketedTimeWindowStats.h>
+#include <util/TimeWindowStats.h>
+#include <modules/JobAttributes.h>
+#include <modules/RequestClass.h>
+#include "Job.h"
 
 using namespace omnetpp;
 
@@ -35,42 +40,196 @@ void SimProbe::initialize(int stage)
         serverRemovedSignal = registerSignal(ExecutionManagerModBase::SIG_SERVER_REMOVED);
         getSimulation()->getSystemModule()->subscribe(serverRemovedSignal, this);
 
+        // rejected by the load balancer, or dropped because a queue was full
+        rejectedSignal = registerSignal("rejected");
+        getSimulation()->getSystemModule()->subscribe(rejectedSignal, this);
+        droppedSignal = registerSignal("dropped");
+        getSimulation()->getSystemModule()->subscribe(droppedSignal, this);
+
+        timedOutSignal = registerSignal("timedOut");
+        getSimulation()->getSystemModule()->subscribe(timedOutSignal, this);
+
+        jobQueueTimeSignal = registerSignal("jobQueueTime");
+        getSimulation()->getSystemModule()->subscribe(jobQueueTimeSignal, this);
+        jobServiceDemandSignal = registerSignal("jobServiceDemand");
+        getSimulation()->getSystemModule()->subscribe(jobServiceDemandSignal, this);
+        jobSlowdownSignal = registerSignal("jobSlowdown");
+        getSimulation()->getSystemModule()->subscribe(jobSlowdownSignal, this);
+
+        queueLengthSignal = registerSignal("queueLength");
+        getSimulation()->getSystemModule()->subscribe(queueLengthSignal, this);
+        runningJobsSignal = registerSignal("runningJobs");
+        getSimulation()->getSystemModule()->subscribe(runningJobsSignal, this);
+        jobCompletedSignal = registerSignal("jobCompleted");
+        getSimulation()->getSystemModule()->subscribe(jobCompletedSignal, this);
+
         Model* pModel = check_and_cast<Model*>(
                         getParentModule()->getSubmodule("model"));
         window = pModel->getEvaluationPeriod();
-        arrival.setWindow(window);
-        basicResponseTime.setWindow(window);
-        optResponseTime.setWindow(window);
+        windowBuckets = par("windowBuckets");
+        arrival = createWindowStats();
+        basicResponseTime = createWindowStats();
+        optResponseTime = createWindowStats();
+        rejected = createWindowStats();
+        timedOut = createWindowStats();
+        basicResponseTimeQuantiles.setWindow(window);
+        optResponseTimeQuantiles.setWindow(window);
+        initLatencyStats(latency);
+
+        unsigned classCount = ::RequestClass::getCount();
+        classStats.resize(classCount);
+        for (unsigned c = 0; c < classCount; c++) {
+            classStats[c].responseTime = createWindowStats();
+            classStats[c].basic = createWindowStats();
+            classStats[c].late = createWindowStats();
+            classStats[c].responseTimeThreshold = ::RequestClass::get(c)->getResponseTimeThreshold();
+        }
     }
 }
 
+std::unique_ptr<WindowStats> SimProbe::createWindowStats() const {
+    std::unique_ptr<WindowStats> pStats;
+    if (windowBuckets > 0) {
+        pStats.reset(new BucketedTimeWindowStats(windowBuckets));
+    } else {
+        pStats.reset(new TimeWindowStats);
+    }
+    pStats->setWindow(window);
+    return pStats;
+}
+
 double SimProbe::getBasicResponseTime() {
-    return basicResponseTime.getAverage();
+    return basicResponseTime->getAverage();
 }
 
 double SimProbe::getOptResponseTime() {
-    return optResponseTime.getAverage();
+    return optResponseTime->getAverage();
 }
 
 double SimProbe::getBasicThroughput() {
-    return basicResponseTime.getRate();
+    return basicResponseTime->getRate();
 }
 
 double SimProbe::getOptThroughput() {
-    return optResponseTime.getRate();
+    return optResponseTime->getRate();
 }
 
 double SimProbe::getUtilization(const std::string& serverName) {
     auto it = utilization.find(serverName);
     if (it != utilization.end()) {
-        return it->second.getPercentageAboveZero();
+        return it->second.getUtilization();
     }
 
     return -1.0; // error: server not found
 }
 
 double SimProbe::getArrivalRate() {
-    return arrival.getRate();
+    return arrival->getRate();
+}
+
+double SimProbe::getRejectedRate() {
+    return rejected->getRate();
+}
+
+double SimProbe::getTimedOutRate() {
+    return timedOut->getRate();
+}
+
+void SimProbe::initLatencyStats(ClassLatencyStats& stats) const {
+    for (auto& classStats : stats) {
+        classStats.queueTime = createWindowStats();
+        classStats.serviceTime = createWindowStats();
+        classStats.slowdown = createWindowStats();
+    }
+}
+
+Observations::LatencyBreakdown SimProbe::getLatencyBreakdown(const LatencyStats& stats) {
+    Observations::LatencyBreakdown breakdown;
+    breakdown.queueTime = stats.queueTime->getAverage();
+    breakdown.serviceTime = stats.serviceTime->getAverage();
+    breakdown.slowdown = stats.slowdown->getAverage();
+    return breakdown;
+}
+
+Observations::LatencyBreakdown SimProbe::getLatencyBreakdown(const std::string& serverName, bool basic) {
+    RequestClass requestClass = (basic) ? BASIC : OPT;
+    if (serverName.empty()) {
+        return getLatencyBreakdown(latency[requestClass]);
+    }
+
+    auto it = serverLatency.find(serverName);
+    if (it != serverLatency.end()) {
+        return getLatencyBreakdown(it->second[requestClass]);
+    }
+
+    return Observations::LatencyBreakdown(); // server not found
+}
+
+Observations::LoadGauges SimProbe::getLoadGauges(const std::string& serverName) {
+    if (serverName.empty()) {
+        return load;
+    }
+
+    auto it = serverLoad.find(serverName);
+    if (it != serverLoad.end()) {
+        return it->second;
+    }
+
+    return Observations::LoadGauges(); // server not found
+}
+
+Observations::LoadGauges* SimProbe::getServerLoad(cComponent* source, SignalSource& signalSource) {
+    if (signalSource.pLoad == nullptr && signalSource.kind != SignalSource::IGNORED) {
+        cModule* parent = source->getParentModule();
+        std::string serverName = parent->getName();
+        if (parent == getSimulation()->getSystemModule() || serverName[0] == 'R') {
+
+            // not in a server (e.g., central queue), or a server being removed
+            signalSource.kind = SignalSource::IGNORED;
+        } else {
+            signalSource.pLoad = &serverLoad[serverName];
+        }
+    }
+    return signalSource.pLoad;
+}
+
+Observations::ClassObservations SimProbe::getClassObservations(unsigned requestClass) {
+    Observations::ClassObservations classObservations;
+    if (requestClass < classStats.size()) {
+        const ClassStats& stats = classStats[requestClass];
+        classObservations.responseTime = stats.responseTime->getAverage();
+        classObservations.throughput = stats.responseTime->getRate();
+        classObservations.basicThroughput = stats.basic->getRate();
+        classObservations.lateRate = stats.late->getRate();
+    }
+    return classObservations;
+}
+
+void SimProbe::recordClassCompletion(cObject* details) {
+    auto job = check_and_cast<queueing::Job*>(details);
+    long requestClass = JobAttributes::getRequestClass(job);
+    if (requestClass < 0 || requestClass >= (long) classStats.size()) {
+        return;
+    }
+
+    // the server sends the job straight to the sink, so this is its response time
+    ClassStats& stats = classStats[requestClass];
+    double responseTime = (simTime() - job->getCreationTime()).dbl();
+    stats.responseTime->record(responseTime);
+    if (job->getKind() == 1) { // kind 1 is low fidelity
+        stats.basic->record(1);
+    }
+    if (responseTime > stats.responseTimeThreshold) {
+        stats.late->record(1);
+    }
+}
+
+double SimProbe::getBasicResponseTimePercentile(double percentile) {
+    return basicResponseTimeQuantiles.getQuantile(percentile / 100);
+}
+
+double SimProbe::getOptResponseTimePercentile(double percentile) {
+    return optResponseTimeQuantiles.getQuantile(percentile / 100);
 }
 
 void SimProbe::handleMessage(cMessage *msg)
@@ -78,14 +237,29 @@ void SimProbe::handleMessage(cMessage *msg)
     // TODO - Generated method body
 }
 
+SimProbe::SignalSource& SimProbe::getSignalSource(cComponent* source) {
+    unsigned id = source->getId();
+    if (id >= signalSources.size()) {
+        signalSources.resize(id + 1);
+    }
+    return signalSources[id];
+}
+
 void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
         const SimTime& t, cObject *details) {
     if (signalID == lifeTimeSignal) {
-        bool basicService = (strcmp(source->getName(), "sinkLow") == 0);
-        if (basicService) {
-            basicResponseTime.record(t.dbl());
+        SignalSource& signalSource = getSignalSource(source);
+        if (signalSource.kind == SignalSource::UNKNOWN) {
+            signalSource.kind = (strcmp(source->getName(), "sinkLow") == 0)
+                    ? SignalSource::BASIC_SINK : SignalSource::OPT_SINK;
+        }
+
+        if (signalSource.kind == SignalSource::BASIC_SINK) {
+            basicResponseTime->record(t.dbl());
+            basicResponseTimeQuantiles.record(t.dbl());
         } else {
-            optResponseTime.record(t.dbl());
+            optResponseTime->record(t.dbl());
+            optResponseTimeQuantiles.record(t.dbl());
        }
     }
 }
@@ -94,14 +268,25 @@ void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
 void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
         bool value, cObject *details) {
     if (signalID == serverBusySignal) {
+        SignalSource& signalSource = getSignalSource(source);
+        if (signalSource.kind == SignalSource::SERVER) {
+            signalSource.pUtilization->setBusy(value);
+            return;
+        } else if (signalSource.kind == SignalSource::IGNORED) {
+            return;
+        }
+
         std::string serverName = source->getParentModule()->getName(); // because it is nested
         if (serverName[0] == 'R') {
             // it is a removed server, skip it
+            signalSource.kind = SignalSource::IGNORED;
             return;
         }
         auto it = utilization.find(serverName);
         if (it != utilization.end()) {
-            it->second.record((value) ? 1.0 : 0.0); // busy vs idle
+            it->second.setBusy(value);
+            signalSource.kind = SignalSource::SERVER;
+            signalSource.pUtilization = &it->second;
         } else {
 
             /*
@@ -112,25 +297,118 @@ void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
             if (value) {
                 auto& util = utilization[serverName];
                 util.setWindow(window);
-                util.record(1.0); // busy
+                util.setBusy(true);
+                signalSource.kind = SignalSource::SERVER;
+                signalSource.pUtilization = &util;
+            }
+        }
+    }
+}
+
+void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
+        long value, cObject *details) {
+    if (signalID == queueLengthSignal) {
+        SignalSource& signalSource = getSignalSource(source);
+        load.queueLength += value - signalSource.queueLength;
+        signalSource.queueLength = value;
+        auto pServerLoad = getServerLoad(source, signalSource);
+        if (pServerLoad) {
+            pServerLoad->queueLength = value;
+        }
+    } else if (signalID == runningJobsSignal) {
+        SignalSource& signalSource = getSignalSource(source);
+        load.runningJobs += value - signalSource.runningJobs;
+        signalSource.runningJobs = value;
+        auto pServerLoad = getServerLoad(source, signalSource);
+        if (pServerLoad) {
+            pServerLoad->runningJobs = value;
+        }
+    } else if (signalID == rejectedSignal || signalID == droppedSignal) {
+        rejected->record(value);
+        load.rejected += value;
+
+        // per server, for drops in its queue and rejections made on its behalf
+        cComponent* pQueue = nullptr;
+        if (signalID == droppedSignal) {
+            pQueue = source;
+        } else if (auto msg = dynamic_cast<cMessage*>(details)) {
+            int queueId = JobAttributes::getRejectingQueue(msg);
+            if (queueId >= 0) {
+                pQueue = getSimulation()->getModule(queueId);
+            }
+        }
+        if (pQueue) {
+            auto pServerLoad = getServerLoad(pQueue, getSignalSource(pQueue));
+            if (pServerLoad) {
+                pServerLoad->rejected += value;
             }
         }
+    } else if (signalID == jobCompletedSignal) {
+        recordClassCompletion(details);
+    } else if (signalID == timedOutSignal) {
+        timedOut->record(value);
+        load.timedOut += value;
+        auto pServerLoad = getServerLoad(source, getSignalSource(source));
+        if (pServerLoad) {
+            pServerLoad->timedOut += value;
+        }
     }
 }
 
 void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID,
         double value, cObject *details) {
     if (signalID == interArrivalSignal) {
-        arrival.record(value);
+        arrival->record(value);
+    } else if (signalID == jobQueueTimeSignal || signalID == jobServiceDemandSignal
+            || signalID == jobSlowdownSignal) {
+        recordJobTime(source, signalID, value, details);
     }
 }
 
+void SimProbe::recordJobTime(cComponent* source, simsignal_t signalID, double value, cObject* details) {
+    auto job = check_and_cast<queueing::Job*>(details);
+    RequestClass requestClass = (job->getKind() == 1) ? BASIC : OPT; // kind 1 is low fidelity
+
+    std::unique_ptr<WindowStats> LatencyStats::* stat = &LatencyStats::slowdown;
+    if (signalID == jobQueueTimeSignal) {
+        stat = &LatencyStats::queueTime;
+    } else if (signalID == jobServiceDemandSignal) {
+        stat = &LatencyStats::serviceTime;
+    }
+    (latency[requestClass].*stat)->record(value);
+
+    // per server, except for servers being removed
+    SignalSource& signalSource = getSignalSource(source);
+    if (signalSource.pLatency == nullptr && signalSource.kind != SignalSource::IGNORED) {
+        std::string serverName = source->getParentModule()->getName(); // because it is nested
+        if (serverName[0] == 'R') {
+            signalSource.kind = SignalSource::IGNORED;
+        } else {
+            auto it = serverLatency.find(serverName);
+            if (it == serverLatency.end()) {
+                it = serverLatency.emplace(serverName, ClassLatencyStats()).first;
+                initLatencyStats(it->second);
+            }
+            signalSource.pLatency = &it->second;
+        }
+    }
+    if (signalSource.pLatency) {
+        ((*signalSource.pLatency)[requestClass].*stat)->record(value);
+    }
+}
+
+void SimProbe::setPercentiles(Observations::Percentiles& percentiles, const QuantileSketch& sketch) {
+    percentiles.p50 = sketch.getQuantile(0.50);
+    percentiles.p95 = sketch.getQuantile(0.95);
+    percentiles.p99 = sketch.getQuantile(0.99);
+}
+
 Observations SimProbe::getUpdatedObservations() {
     Observations obs;
     obs.utilization = 0;
 
     for (auto& entry : utilization) {
-        obs.utilization += entry.second.getPercentageAboveZero();
+        obs.utilization += entry.second.getUtilization();
     }
 
     obs.basicResponseTime = getBasicResponseTime();
@@ -139,6 +417,23 @@ Observations SimProbe::getUpdatedObservations() {
     obs.optThroughput = getOptThroughput();
     obs.avgResponseTime = (obs.basicResponseTime * obs.basicThroughput + obs.optResponseTime * obs.optThroughput)
             / (obs.basicThroughput + obs.optThroughput);
+    obs.rejectedRate = getRejectedRate();
+    obs.timedOutRate = getTimedOutRate();
+
+    const QuantileSketch& basicSketch = basicResponseTimeQuantiles.getSketch();
+    const QuantileSketch& optSketch = optResponseTimeQuantiles.getSketch();
+    QuantileSketch allSketch = basicSketch;
+    allSketch.merge(optSketch);
+    setPercentiles(obs.basicResponseTimePercentiles, basicSketch);
+    setPercentiles(obs.optResponseTimePercentiles, optSketch);
+    setPercentiles(obs.responseTimePercentiles, allSketch);
+
+    obs.basicLatency = getLatencyBreakdown(latency[BASIC]);
+    obs.optLatency = getLatencyBreakdown(latency[OPT]);
+    obs.load = load;
+    for (unsigned c = 0; c < classStats.size(); c++) {
+        obs.classes.push_back(getClassObservations(c));
+    }
 
     return obs;
 }
@@ -149,7 +444,11 @@ Environment SimProbe::getUpdatedEnvironment() {
 
     Environment environment;
     environment.setArrivalMean(measuredMeanInterArrival);
-    environment.setArrivalVariance(pow(measuredMeanInterArrival, 2)); // assume exponential distribution
+    if (arrival->getCount() > 1) {
+        environment.setArrivalVariance(arrival->getVariance());
+    } else {
+        environment.setArrivalVariance(pow(measuredMeanInterArrival, 2)); // not enough samples, assume exponential distribution
+    }
     return environment;
 }
 
@@ -157,8 +456,32 @@ Environment SimProbe::getUpdatedEnvironment() {
 void SimProbe::receiveSignal(cComponent *source, simsignal_t signalID, const char* value, cObject *details) {
     if (signalID == serverRemovedSignal) {
         auto it = utilization.find(value);
-        if (it != utilization.end()) {
+        UtilizationTracker* pUtilization = (it != utilization.end()) ? &it->second : nullptr;
+        auto latencyIt = serverLatency.find(value);
+        ClassLatencyStats* pLatency = (latencyIt != serverLatency.end()) ? &latencyIt->second : nullptr;
+        auto loadIt = serverLoad.find(value);
+        Observations::LoadGauges* pLoad = (loadIt != serverLoad.end()) ? &loadIt->second : nullptr;
+
+        // the server is being removed, so ignore its signals from now on
+        for (auto& signalSource : signalSources) {
+            if ((pUtilization && signalSource.pUtilization == pUtilization)
+                    || (pLatency && signalSource.pLatency == pLatency)
+                    || (pLoad && signalSource.pLoad == pLoad)) {
+                signalSource.kind = SignalSource::IGNORED;
+                signalSource.pUtilization = nullptr;
+                signalSource.pLatency = nullptr;
+                signalSource.pLoad = nullptr;
+            }
+        }
+
+        if (pUtilization) {
             utilization.erase(it);
         }
+        if (pLatency) {
+            serverLatency.erase(latencyIt);
+        }
+        if (pLoad) {
+            serverLoad.erase(loadIt);
+        }
     }
 }
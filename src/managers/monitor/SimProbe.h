@@ -16,7 +16,12 @@
 #define __PLASASIM_SIMPROBE_H_
 
 #include "IProbe.h"
-#include <util/TimeWindowStats.h>
+#include <util/WindowStats.h>
+#include <util/UtilizationTracker.h>
+#include <util/TimeWindowQuantiles.h>
+#include <memory>
+#include <array>
+#include <vector>
 
 /**
  * This class collects statistics from the simulated system
@@ -26,6 +31,7 @@ class SimProbe : public IProbe, omnetpp::cListener
 public:
     void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, const omnetpp::SimTime& t, cObject *details) override;
     void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, bool value, cObject *details) override;
+    void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, long value, cObject *details) override;
     void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, double value, cObject *details) override;
     void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, const char* value, cObject *details) override;
 
@@ -35,6 +41,13 @@ public:
     double getOptThroughput();
     double getUtilization(const std::string& serverName);
     double getArrivalRate();
+    double getRejectedRate();
+    double getTimedOutRate();
+    double getBasicResponseTimePercentile(double percentile);
+    double getOptResponseTimePercentile(double percentile);
+    Observations::LatencyBreakdown getLatencyBreakdown(const std::string& serverName, bool basic);
+    Observations::LoadGauges getLoadGauges(const std::string& serverName);
+    Observations::ClassObservations getClassObservations(unsigned requestClass);
 
     Observations getUpdatedObservations();
     Environment getUpdatedEnvironment();
@@ -45,13 +58,104 @@ protected:
     omnetpp::simsignal_t interArrivalSignal;
     omnetpp::simsignal_t serverBusySignal;
     omnetpp::simsignal_t serverRemovedSignal;
+    omnetpp::simsignal_t rejectedSignal;
+    omnetpp::simsignal_t droppedSignal;
+    omnetpp::simsignal_t timedOutSignal;
+    omnetpp::simsignal_t jobQueueTimeSignal;
+    omnetpp::simsignal_t jobServiceDemandSignal;
+    omnetpp::simsignal_t jobSlowdownSignal;
+    omnetpp::simsignal_t queueLengthSignal;
+    omnetpp::simsignal_t runningJobsSignal;
+    omnetpp::simsignal_t jobCompletedSignal;
 
     unsigned window; /**< time window in seconds for statistics */
-    TimeWindowStats arrival;
-    TimeWindowStats basicResponseTime;
-    TimeWindowStats optResponseTime;
+    unsigned windowBuckets; /**< buckets per window (0 to keep every entry) */
+    std::unique_ptr<WindowStats> arrival;
+    std::unique_ptr<WindowStats> basicResponseTime;
+    std::unique_ptr<WindowStats> optResponseTime;
+    std::unique_ptr<WindowStats> rejected;
+    std::unique_ptr<WindowStats> timedOut;
+    TimeWindowQuantiles basicResponseTimeQuantiles;
+    TimeWindowQuantiles optResponseTimeQuantiles;
 
-    std::map<std::string, TimeWindowStats> utilization;
+    std::map<std::string, UtilizationTracker> utilization;
+
+    /** time windows for the latency breakdown of the requests of one class */
+    struct LatencyStats {
+        std::unique_ptr<WindowStats> queueTime;
+        std::unique_ptr<WindowStats> serviceTime;
+        std::unique_ptr<WindowStats> slowdown;
+    };
+
+    enum RequestClass { BASIC, OPT };
+    typedef std::array<LatencyStats, 2> ClassLatencyStats; /**< indexed by RequestClass */
+
+    ClassLatencyStats latency; /**< all servers */
+    std::map<std::string, ClassLatencyStats> serverLatency;
+
+    Observations::LoadGauges load; /**< all servers */
+    std::map<std::string, Observations::LoadGauges> serverLoad;
+
+    /** time windows for the completions of the requests of a request class */
+    struct ClassStats {
+        std::unique_ptr<WindowStats> responseTime;
+        std::unique_ptr<WindowStats> basic; /**< served with low fidelity */
+        std::unique_ptr<WindowStats> late; /**< above responseTimeThreshold */
+        double responseTimeThreshold;
+    };
+
+    /** indexed by request class (see RequestClass) */
+    std::vector<ClassStats> classStats;
+
+    /**
+     * Records the response time of a job completed by a server, if it
+     * has a request class
+     */
+    void recordClassCompletion(cObject* details);
+
+    /**
+     * What the module that emits a signal is, resolved from its name the
+     * first time it emits, so that per-job signals need no string handling
+     */
+    struct SignalSource {
+        enum Kind : char { UNKNOWN, BASIC_SINK, OPT_SINK, SERVER, IGNORED };
+        Kind kind = UNKNOWN;
+        UtilizationTracker* pUtilization = nullptr; /**< for SERVER */
+        ClassLatencyStats* pLatency = nullptr; /**< for SERVER */
+
+        /* for the queues and servers inside an AppServer */
+        Observations::LoadGauges* pLoad = nullptr;
+        long queueLength = 0; /**< last value, to update the total */
+        long runningJobs = 0; /**< last value, to update the total */
+    };
+
+    /** signal sources indexed by module id */
+    std::vector<SignalSource> signalSources;
+
+    SignalSource& getSignalSource(omnetpp::cComponent* source);
+
+    /**
+     * Creates the statistics for a time window, bucketed if windowBuckets > 0
+     */
+    std::unique_ptr<WindowStats> createWindowStats() const;
+
+    void initLatencyStats(ClassLatencyStats& stats) const;
+
+    /**
+     * Records the queueing time, service demand or slowdown of a job
+     * completed by a server
+     */
+    void recordJobTime(omnetpp::cComponent* source, omnetpp::simsignal_t signalID, double value, cObject* details);
+
+    static Observations::LatencyBreakdown getLatencyBreakdown(const LatencyStats& stats);
+
+    /**
+     * Returns the load gauges of the server that contains the source, or
+     * nullptr if it is not in a server (e.g., a central queue)
+     */
+    Observations::LoadGauges* getServerLoad(omnetpp::cComponent* source, SignalSource& signalSource);
+
+    static void setPercentiles(Observations::Percentiles& percentiles, const QuantileSketch& sketch);
 
     virtual int numInitStages() const {return 2;}
     virtual void initialize(int stage);
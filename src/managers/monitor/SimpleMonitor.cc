@@ -38,6 +38,8 @@ void SimpleMonitor::initialize(int stage) {
         measuredInterarrivalStdDev = registerSignal("measuredInterarrivalStdDev");
         utilitySignal = registerSignal("utility");
         brownoutFactorSignal = registerSignal("brownoutFactor");
+        estimatedArrivalRateSignal = registerSignal("estimatedArrivalRate");
+        estimatedArrivalRateStdDevSignal = registerSignal("estimatedArrivalRateStdDev");
 
         serverRemovedSignal = registerSignal(ExecutionManagerModBase::SIG_SERVER_REMOVED);
         serverAddedSignal = registerSignal(ExecutionManagerModBase::SIG_SERVER_ADDED);
@@ -46,6 +48,17 @@ void SimpleMonitor::initialize(int stage) {
 
         oversamplingFactor = par("oversamplingFactor");
 
+        const char* estimatorName = par("arrivalRateEstimator");
+        if (strcmp(estimatorName, "ewma") == 0) {
+            pArrivalRateEstimator.reset(new EwmaArrivalRateEstimator(par("estimatorAlpha")));
+        } else if (strcmp(estimatorName, "holt") == 0) {
+            pArrivalRateEstimator.reset(new HoltArrivalRateEstimator(par("estimatorAlpha"), par("estimatorBeta")));
+        } else if (strcmp(estimatorName, "kalman") == 0) {
+            pArrivalRateEstimator.reset(new KalmanArrivalRateEstimator(par("kalmanProcessNoise")));
+        } else if (strcmp(estimatorName, "") != 0) {
+            error("unknown arrival rate estimator %s", estimatorName);
+        }
+
         EV << "subscribing to signals" << endl;
         getSimulation()->getSystemModule()->subscribe(serverRemovedSignal, this);
         getSimulation()->getSystemModule()->subscribe(serverAddedSignal, this);
@@ -122,9 +135,37 @@ void SimpleMonitor::periodicHandler() {
 
 void SimpleMonitor::oversamplingHandler() {
     Environment environment = pProbe->getUpdatedEnvironment();
+    if (pArrivalRateEstimator) {
+        estimateArrivalRate(environment);
+    }
     pModel->setEnvironment(environment);
 }
 
+void SimpleMonitor::estimateArrivalRate(Environment& environment) {
+    double window = pModel->getEvaluationPeriod();
+    double measuredRate = (environment.getArrivalMean() > 0) ? (1 / environment.getArrivalMean()) : 0;
+
+    /*
+     * for Poisson arrivals, the variance of the rate measured in the window
+     * is rate / window. The rate is floored at one arrival per window so that
+     * a measurement of 0 isn't taken as exact
+     */
+    double measurementVariance = max(measuredRate, 1 / window) / window;
+    pArrivalRateEstimator->update(measuredRate, measurementVariance, window / oversamplingFactor);
+
+    // keep the measured burstiness (SCV), assuming exponential if nothing was measured
+    double scv = (environment.getArrivalMean() > 0) ? environment.getArrivalScv() : 1.0;
+
+    double rate = max(pArrivalRateEstimator->getRate(), 0.0);
+    double meanInterArrival = (rate > 0) ? (1 / rate) : 0;
+    environment.setArrivalMean(meanInterArrival);
+    environment.setArrivalVariance(scv * pow(meanInterArrival, 2));
+    environment.setArrivalRateVariance(pArrivalRateEstimator->getVariance());
+
+    emit(estimatedArrivalRateSignal, rate);
+    emit(estimatedArrivalRateStdDevSignal, sqrt(pArrivalRateEstimator->getVariance()));
+}
+
 void SimpleMonitor::postPeriodHandler() {
     emit(numberOfServersSignal, pModel->getServers());
     emit(activeServersSignal,
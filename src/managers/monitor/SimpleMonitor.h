@@ -20,6 +20,7 @@
 #include <memory>
 #include "model/Model.h"
 #include "IProbe.h"
+#include "util/ArrivalRateEstimators.h"
 
 #define DLL_PUBLIC __attribute__ ((visibility("default")))
 
@@ -46,12 +47,23 @@ class DLL_PUBLIC SimpleMonitor : public omnetpp::cSimpleModule, omnetpp::cListen
     omnetpp::simsignal_t measuredInterarrivalStdDev;
     omnetpp::simsignal_t utilitySignal;
     omnetpp::simsignal_t brownoutFactorSignal;
+    omnetpp::simsignal_t estimatedArrivalRateSignal;
+    omnetpp::simsignal_t estimatedArrivalRateStdDevSignal;
 
     Model* pModel;
     IProbe* pProbe;
 
     unsigned oversamplingFactor;
 
+    /** filters the measured arrival rate (null to use the measurement as is) */
+    std::unique_ptr<ArrivalRateEstimator> pArrivalRateEstimator;
+
+    /**
+     * Updates the arrival rate estimator with the measured environment and
+     * replaces the measured arrival rate with the estimate
+     */
+    void estimateArrivalRate(Environment& environment);
+
     virtual int numInitStages() const {return 2;}
     virtual void initialize(int stage);
     virtual void handleMessage(omnetpp::cMessage *msg);
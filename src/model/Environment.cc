@@ -14,10 +14,10 @@
  *******************************************************************************/
 #include "Environment.h"
 
-Environment::Environment() : arrivalMean(0), arrivalVariance(0) {}
+Environment::Environment() : arrivalMean(0), arrivalVariance(0), arrivalRateVariance(0) {}
 
 Environment::Environment(double arrivalMean, double arrivalStdDev)
-    : arrivalMean(arrivalMean), arrivalVariance(arrivalStdDev) {};
+    : arrivalMean(arrivalMean), arrivalVariance(arrivalStdDev), arrivalRateVariance(0) {};
 
 double Environment::getArrivalMean() const {
     return arrivalMean;
@@ -35,6 +35,18 @@ void Environment::setArrivalVariance(double arrivalVariance) {
     this->arrivalVariance = arrivalVariance;
 }
 
+double Environment::getArrivalScv() const {
+    return (arrivalMean > 0) ? arrivalVariance / (arrivalMean * arrivalMean) : 0;
+}
+
+double Environment::getArrivalRateVariance() const {
+    return arrivalRateVariance;
+}
+
+void Environment::setArrivalRateVariance(double arrivalRateVariance) {
+    this->arrivalRateVariance = arrivalRateVariance;
+}
+
 void Environment::printOn(std::ostream& os) const {
     os << "environment[interArrival mean=" << arrivalMean << ", variance=" << arrivalVariance << "]";
 }
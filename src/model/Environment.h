@@ -22,6 +22,7 @@
 class Environment : public pladapt::Environment {
     double arrivalMean;
     double arrivalVariance;
+    double arrivalRateVariance; /**< uncertainty of the estimated arrival rate (0 if not estimated) */
 public:
     Environment();
     Environment(double arrivalMean, double arrivalVariance);
@@ -31,6 +32,14 @@ public:
     double getArrivalVariance() const;
     void setArrivalVariance(double arrivalVariance);
 
+    /**
+     * Returns the squared coefficient of variation of the interarrival time
+     * (1 for Poisson arrivals, > 1 for bursty arrivals), or 0 if the mean is 0
+     */
+    double getArrivalScv() const;
+    double getArrivalRateVariance() const;
+    void setArrivalRateVariance(double arrivalRateVariance);
+
     virtual double asDouble() const;
 };
 
@@ -31,7 +31,7 @@ Define_Module(Model);
 const char* Model::HORIZON_PAR = "horizon";
 
 Model::Model()
-    : activeServerCountLast(0), timeActiveServerCountLast(0.0), activeServers(0)
+    : activeServerCountLast(0), timeActiveServerCountLast(0.0), activeServers(0), admissionRate(0)
 {
 }
 
@@ -140,12 +140,35 @@ void Model::removeServer()
 
 void Model::setBrownoutFactor(double factor) {
     brownoutFactor = factor;
+    classBrownoutFactors.clear();
 }
 
 double Model::getBrownoutFactor() const {
     return brownoutFactor;
 }
 
+void Model::setClassBrownoutFactor(unsigned requestClass, double factor) {
+    if (requestClass >= classBrownoutFactors.size()) {
+        classBrownoutFactors.resize(requestClass + 1, -1.0);
+    }
+    classBrownoutFactors[requestClass] = factor;
+}
+
+double Model::getClassBrownoutFactor(unsigned requestClass) const {
+    if (requestClass < classBrownoutFactors.size() && classBrownoutFactors[requestClass] >= 0) {
+        return classBrownoutFactors[requestClass];
+    }
+    return brownoutFactor;
+}
+
+void Model::setAdmissionRate(double rate) {
+    admissionRate = rate;
+}
+
+double Model::getAdmissionRate() const {
+    return admissionRate;
+}
+
 void Model::setDimmerFactor(double factor) {
     setBrownoutFactor(1.0 - factor);
 }
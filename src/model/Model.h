@@ -18,6 +18,7 @@
 
 #include <omnetpp.h>
 #include <set>
+#include <vector>
 #include "Configuration.h"
 #include "Environment.h"
 #include "Observations.h"
@@ -67,6 +68,8 @@ protected:
     // these hold the current configuration, plus the events for the booting server
     int activeServers; /**< number of active servers (there is one more powered up if a server is booting) */
     double brownoutFactor;
+    double admissionRate; /**< max requests per second admitted (0 for no limit) */
+    std::vector<double> classBrownoutFactors; /**< per request class, negative if it is brownoutFactor */
 
     Environment environment;
     Observations observations;
@@ -144,12 +147,22 @@ public:
     void setBrownoutFactor(double factor);
     double getBrownoutFactor() const;
 
+    /**
+     * Brownout factor of one request class. Setting the brownout factor
+     * of all requests overrides the ones set for the classes.
+     */
+    void setClassBrownoutFactor(unsigned requestClass, double factor);
+    double getClassBrownoutFactor(unsigned requestClass) const;
+
     int getNumberOfBrownoutLevels() const;
     double brownoutLevelToFactor(int brownoutLevel) const;
     int brownoutFactorToLevel(double brownoutFactor) const;
 
     double getDimmerMargin() const;
 
+    void setAdmissionRate(double rate);
+    double getAdmissionRate() const;
+
     virtual ~Model();
 };
 
@@ -15,5 +15,13 @@
 
 #include "Observations.h"
 
-Observations::Observations() : avgResponseTime(0.0), utilization(0.0) {}
+Observations::Observations() : avgResponseTime(0.0), utilization(0.0), rejectedRate(0.0), timedOutRate(0.0) {}
+
+Observations::Percentiles::Percentiles() : p50(0.0), p95(0.0), p99(0.0) {}
+
+Observations::LatencyBreakdown::LatencyBreakdown() : queueTime(0.0), serviceTime(0.0), slowdown(0.0) {}
+
+Observations::LoadGauges::LoadGauges() : queueLength(0), runningJobs(0), timedOut(0), rejected(0) {}
+
+Observations::ClassObservations::ClassObservations() : responseTime(0.0), throughput(0.0), basicThroughput(0.0), lateRate(0.0) {}
 
@@ -16,14 +16,72 @@
 #ifndef OBSERVATIONS_H_
 #define OBSERVATIONS_H_
 
+#include <vector>
+
 class Observations {
 public:
+
+    /**
+     * Response time percentiles (0 if not available)
+     */
+    struct Percentiles {
+        double p50;
+        double p95;
+        double p99;
+
+        Percentiles();
+    };
+
+    /**
+     * Breakdown of the time requests spend in the servers (0 if not available)
+     */
+    struct LatencyBreakdown {
+        double queueTime; /**< mean time waiting in queues */
+        double serviceTime; /**< mean service demand (i.e., as if the processor were not shared) */
+        double slowdown; /**< mean processor sharing slowdown (time in the server / service demand) */
+
+        LatencyBreakdown();
+    };
+
+    /**
+     * Load of the servers when observed
+     */
+    struct LoadGauges {
+        long queueLength; /**< jobs waiting in queues */
+        long runningJobs; /**< jobs being served */
+        long timedOut; /**< requests that timed out (since the start) */
+        long rejected; /**< requests rejected or dropped because a queue was full (since the start) */
+
+        LoadGauges();
+    };
+
+    /**
+     * Statistics of the requests of one request class (0 if not available)
+     */
+    struct ClassObservations {
+        double responseTime; /**< mean response time of the completed requests */
+        double throughput; /**< completed requests per second */
+        double basicThroughput; /**< completed requests per second served with low fidelity */
+        double lateRate; /**< completed requests per second above the response time threshold of the class */
+
+        ClassObservations();
+    };
+
     double basicResponseTime;
     double optResponseTime;
     double basicThroughput;
     double optThroughput;
     double avgResponseTime;
     double utilization;
+    double rejectedRate; /**< requests per second rejected by admission control or full queues */
+    double timedOutRate; /**< requests per second that timed out before being served */
+    Percentiles basicResponseTimePercentiles;
+    Percentiles optResponseTimePercentiles;
+    Percentiles responseTimePercentiles; /**< all requests */
+    LatencyBreakdown basicLatency;
+    LatencyBreakdown optLatency;
+    LoadGauges load; /**< all servers */
+    std::vector<ClassObservations> classes; /**< per request class (empty if there are none) */
 
     Observations();
 };
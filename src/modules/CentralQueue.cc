@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "CentralQueue.h"
+#include "ServerQueue.h"
+#include "MTServer.h"
+#include "Job.h"
+#include <managers/execution/ExecutionManagerMod.h>
+
+using namespace omnetpp;
+
+Define_Module(CentralQueue);
+
+CentralQueue::CentralQueue() : capacity(-1), admissionBurst(1), lastIndex(-1), pRegistry(nullptr) {}
+
+CentralQueue::~CentralQueue() {
+}
+
+void CentralQueue::initialize()
+{
+    queueingTimeSignal = registerSignal("queueingTime");
+    queueLengthSignal = registerSignal("queueLength");
+    threadAvailableSignal = registerSignal("threadAvailable");
+    rejectedSignal = registerSignal("rejected");
+    emit(queueLengthSignal, 0);
+
+    capacity = par("capacity");
+    admissionBurst = par("admissionBurst");
+    if (admissionBurst < 1) {
+        error("admissionBurst must be at least 1");
+    }
+    admission.setRate(par("admissionRate"), admissionBurst);
+    queue.setName("queue");
+
+    pRegistry = &(check_and_cast<ExecutionManagerMod*>(
+            getParentModule()->getSubmodule("executionManager"))->getServerRegistry());
+    getSimulation()->getSystemModule()->subscribe(threadAvailableSignal, this);
+}
+
+void CentralQueue::handleMessage(cMessage *msg)
+{
+    if (!admission.admit()) {
+        emit(rejectedSignal, 1L, msg);
+        delete msg;
+        return;
+    }
+
+    queueing::Job *job = check_and_cast<queueing::Job *>(msg);
+    job->setTimestamp();
+
+    /*
+     * if there are jobs queued, no server can be available, because it
+     * would have pulled them already
+     */
+    if (queue.isEmpty()) {
+        unsigned servers = pRegistry->size();
+        for (unsigned i = 0; i < servers; i++) {
+            lastIndex = (lastIndex + 1) % servers;
+            if (isAvailable(lastIndex)) {
+                sendToServer(job, lastIndex);
+                return;
+            }
+        }
+    }
+
+    // reject if the queue is full, as the load balancer does with queueCapacity
+    if (capacity >= 0 && queue.getLength() >= capacity) {
+        EV << "Queue full! Job rejected.\n";
+        if (hasGUI())
+            bubble("Rejected!");
+        admission.refund();
+        emit(rejectedSignal, 1L, msg);
+        delete msg;
+        return;
+    }
+
+    queue.insert(job);
+    emit(queueLengthSignal, length());
+    job->setQueueCount(job->getQueueCount() + 1);
+}
+
+void CentralQueue::refreshDisplay() const
+{
+    // change the icon color
+    getDisplayString().setTagArg("i", 1, queue.isEmpty() ? "" : "cyan");
+}
+
+int CentralQueue::length() const {
+    return queue.getLength();
+}
+
+void CentralQueue::setAdmissionRate(double rate) {
+    Enter_Method("setAdmissionRate()");
+    admission.setRate(rate, admissionBurst);
+}
+
+double CentralQueue::getAdmissionRate() const {
+    return admission.getRate();
+}
+
+bool CentralQueue::isAvailable(unsigned index) const {
+    const ServerRegistry::Entry& entry = (*pRegistry)[index];
+    return entry.pServer->getIdleThreadCount() > (unsigned) entry.pQueue->length() + entry.pQueue->getExpectedJobCount();
+}
+
+void CentralQueue::dispatch(unsigned index) {
+    queueing::Job *job = (queueing::Job *) queue.pop();
+    emit(queueLengthSignal, length());
+
+    simtime_t d = simTime() - job->getTimestamp();
+    job->setTotalQueueingTime(job->getTotalQueueingTime() + d);
+    emit(queueingTimeSignal, d);
+
+    sendToServer(job, index);
+}
+
+void CentralQueue::sendToServer(queueing::Job* job, unsigned index) {
+    (*pRegistry)[index].pQueue->expectJob();
+    send(job, "out", index);
+}
+
+void CentralQueue::serverAttached(unsigned index) {
+    Enter_Method("serverAttached()");
+
+    /*
+     * send only one job. When it arrives, the server will signal if it
+     * still has idle threads
+     */
+    if (!queue.isEmpty() && isAvailable(index)) {
+        dispatch(index);
+    }
+}
+
+void CentralQueue::receiveSignal(cComponent *source, simsignal_t signalID, bool value, cObject *details) {
+    if (signalID == threadAvailableSignal && !queue.isEmpty()) {
+
+        // servers being removed are no longer in the registry, so they don't get more jobs
+        int index = pRegistry->find(source->getParentModule()->getId());
+        if (index >= 0 && isAvailable(index)) {
+            Enter_Method_Silent("receiveSignal()");
+            dispatch(index);
+        }
+    }
+}
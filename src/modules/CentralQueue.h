@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_CENTRALQUEUE_H_
+#define __PLASA_CENTRALQUEUE_H_
+
+#include <omnetpp.h>
+#include "ServerRegistry.h"
+
+namespace queueing {
+    class Job;
+}
+#include <util/TokenBucket.h>
+
+/**
+ * Queue shared by all the servers
+ *
+ * Arriving jobs are sent to a server with an idle thread if there is one,
+ * and queued otherwise. Servers pull queued jobs when a thread becomes
+ * available (signaled by MTServer with threadAvailable).
+ */
+class CentralQueue : public omnetpp::cSimpleModule, omnetpp::cListener
+{
+  protected:
+    omnetpp::simsignal_t queueLengthSignal;
+    omnetpp::simsignal_t queueingTimeSignal;
+    omnetpp::simsignal_t threadAvailableSignal;
+    omnetpp::simsignal_t rejectedSignal;
+
+    int capacity;
+    double admissionBurst;
+    TokenBucket admission;
+    omnetpp::cQueue queue;
+    int lastIndex; /**< last server a job was sent to on arrival */
+    const ServerRegistry* pRegistry;
+
+    virtual void initialize();
+    virtual void handleMessage(omnetpp::cMessage *msg);
+    virtual void refreshDisplay() const;
+
+    /**
+     * @return true if the server has an idle thread that is not taken by
+     *   the jobs in its own queue or on their way to it
+     */
+    bool isAvailable(unsigned index) const;
+
+    /**
+     * Sends the job at the head of the queue to a server
+     */
+    void dispatch(unsigned index);
+
+    /**
+     * Sends a job to a server, which must be available
+     *
+     * The server only sees the job when it arrives, so the job is announced
+     * to its queue, which keeps the server from looking available again
+     * for the same thread (e.g., to another arrival at the same time).
+     */
+    void sendToServer(queueing::Job* job, unsigned index);
+
+  public:
+    CentralQueue();
+    virtual ~CentralQueue();
+
+    int length() const;
+
+    /**
+     * Limits the rate of requests admitted. Requests above the rate are rejected
+     *
+     * @param rate requests per second (0 for no limit)
+     */
+    void setAdmissionRate(double rate);
+    double getAdmissionRate() const;
+
+    /**
+     * Called by the execution manager when a server is connected to the
+     * queue, so that it can start pulling jobs
+     *
+     * Servers are detached by removing them from the registry, which makes
+     * them ignored when they signal that they have idle threads.
+     */
+    void serverAttached(unsigned index);
+
+    virtual void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, bool value, omnetpp::cObject *details) override;
+};
+
+#endif
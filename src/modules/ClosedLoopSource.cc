@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "ClosedLoopSource.h"
+#include "Job.h"
+#include "JobAttributes.h"
+
+using namespace std;
+
+Define_Module(ClosedLoopSource);
+
+const int REQUEST_CLASS_RNG = 5;
+
+ClosedLoopSource::ClosedLoopSource() : activeUsers(0), nextSessionId(0),
+        nextScheduleEntry(0), populationTimer(nullptr) {
+}
+
+ClosedLoopSource::~ClosedLoopSource() {
+    for (User& user : users) {
+        cancelAndDelete(user.timer);
+    }
+    cancelAndDelete(populationTimer);
+}
+
+void ClosedLoopSource::initialize()
+{
+    SourceBase::initialize();
+    activeUsersSignal = registerSignal("activeUsers");
+    abandonedSignal = registerSignal("abandoned");
+    jobCompletedSignal = registerSignal("jobCompleted");
+    timedOutSignal = registerSignal("timedOut");
+    rejectedSignal = registerSignal("rejected");
+    droppedSignal = registerSignal("dropped");
+
+    cModule* systemModule = getSimulation()->getSystemModule();
+    systemModule->subscribe(jobCompletedSignal, this);
+    systemModule->subscribe(timedOutSignal, this);
+    systemModule->subscribe(rejectedSignal, this);
+    systemModule->subscribe(droppedSignal, this);
+
+    WATCH(activeUsers);
+    requestClassMix.load();
+    demandSampler.initialize(this);
+
+    parsePopulationSchedule(par("populationSchedule").stringValue());
+    populationTimer = new cMessage("populationTimer");
+    if (!populationSchedule.empty()) {
+        scheduleAt(populationSchedule[0].first, populationTimer);
+    }
+
+    setUsers(par("users"));
+}
+
+void ClosedLoopSource::parsePopulationSchedule(const char* schedule) {
+    cStringTokenizer entryTokenizer(schedule, ",");
+    while (entryTokenizer.hasMoreTokens()) {
+        vector<double> values = cStringTokenizer(entryTokenizer.nextToken()).asDoubleVector();
+        if (values.size() != 2 || values[1] < 0) {
+            error("ClosedLoopSource %s: populationSchedule must be \"time users, ...\"", getFullName());
+        }
+        if (!populationSchedule.empty() && values[0] < populationSchedule.back().first) {
+            error("ClosedLoopSource %s: populationSchedule must be in time order", getFullName());
+        }
+        populationSchedule.push_back(make_pair(values[0], (unsigned) values[1]));
+    }
+}
+
+void ClosedLoopSource::handleMessage(cMessage *msg)
+{
+    ASSERT(msg->isSelfMessage());
+
+    if (msg == populationTimer) {
+        setUsers(populationSchedule[nextScheduleEntry++].second);
+        if (nextScheduleEntry < populationSchedule.size()) {
+            scheduleAt(populationSchedule[nextScheduleEntry].first, populationTimer);
+        }
+        return;
+    }
+
+    User& user = *static_cast<User*>(msg->getContextPointer());
+    if (msg->getKind() == THINK) {
+        issueRequest(user);
+    } else {
+        // the request took longer than the patience of the user
+        abandon(user);
+    }
+}
+
+void ClosedLoopSource::issueRequest(User& user) {
+    if (user.remainingRequests == 0) {
+        user.sessionId = nextSessionId++;
+        user.remainingRequests = par("sessionLength");
+        if (user.remainingRequests <= 0) {
+            user.remainingRequests = -1;
+        }
+    }
+
+    queueing::Job *job = createJob();
+    JobAttributes::setSessionId(job, user.sessionId);
+    JobAttributes::setUserId(job, user.index);
+    if (!requestClassMix.isEmpty()) {
+        JobAttributes::setRequestClass(job, requestClassMix.select(uniform(0, 1, REQUEST_CLASS_RNG)));
+    }
+    if (demandSampler.isEnabled()) {
+        demandSampler.sample(job);
+    }
+    user.jobId = job->getId();
+    if (user.remainingRequests > 0) {
+        user.remainingRequests--;
+    }
+
+    double patience = par("patience");
+    if (patience > 0) {
+        user.timer->setKind(PATIENCE);
+        scheduleAt(simTime() + patience, user.timer);
+    }
+    send(job, "out");
+}
+
+void ClosedLoopSource::think(User& user) {
+    if (!user.active) {
+        return;
+    }
+
+    // a new session starts after a longer pause
+    double thinkTime = (user.remainingRequests == 0) ? par("sessionInterval") : par("thinkTime");
+    user.timer->setKind(THINK);
+    scheduleAt(simTime() + thinkTime, user.timer);
+}
+
+void ClosedLoopSource::abandon(User& user) {
+    user.jobId = -1;
+    user.remainingRequests = 0;
+    emit(abandonedSignal, 1L);
+    think(user);
+}
+
+void ClosedLoopSource::requestFinished(cMessage* job, bool failed) {
+    long userId;
+    if (!JobAttributes::getUserId(job, userId) || userId < 0 || userId >= (long) users.size()) {
+        return;
+    }
+
+    // the user may have abandoned this request already
+    User& user = users[userId];
+    if (user.jobId != job->getId()) {
+        return;
+    }
+
+    Enter_Method_Silent("requestFinished()");
+    cancelEvent(user.timer);
+    if (failed) {
+        abandon(user);
+    } else {
+        user.jobId = -1;
+        think(user);
+    }
+}
+
+void ClosedLoopSource::setUsers(unsigned count) {
+    Enter_Method("setUsers()");
+
+    // bring back users that are leaving before adding new ones
+    for (auto it = users.begin(); activeUsers < count && it != users.end(); ++it) {
+        if (!it->active) {
+            it->active = true;
+            activeUsers++;
+            if (it->jobId < 0) {
+                think(*it);
+            }
+        }
+    }
+    while (activeUsers < count) {
+        User user;
+        user.index = users.size();
+        user.timer = new cMessage("userTimer");
+        user.jobId = -1;
+        user.sessionId = -1;
+        user.remainingRequests = 0;
+        user.active = true;
+        users.push_back(user);
+        users.back().timer->setContextPointer(&users.back());
+        activeUsers++;
+        think(users.back());
+    }
+
+    for (auto it = users.rbegin(); activeUsers > count && it != users.rend(); ++it) {
+        if (it->active) {
+            it->active = false;
+            activeUsers--;
+            if (it->jobId < 0) {
+                cancelEvent(it->timer);
+            }
+        }
+    }
+
+    emit(activeUsersSignal, (long) activeUsers);
+}
+
+unsigned ClosedLoopSource::getUsers() const {
+    return activeUsers;
+}
+
+void ClosedLoopSource::receiveSignal(cComponent *source, simsignal_t signalID, long value, cObject *details) {
+    cMessage* job = dynamic_cast<cMessage*>(details);
+    if (job) {
+        requestFinished(job, signalID != jobCompletedSignal);
+    }
+}
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef CLOSEDLOOPSOURCE_H_
+#define CLOSEDLOOPSOURCE_H_
+
+#include "Source.h"
+#include "RequestClass.h"
+#include "JobDemandSampler.h"
+#include <deque>
+#include <utility>
+#include <vector>
+
+/**
+ * Generates jobs from a closed population of users
+ *
+ * Each user issues a request, waits for it to complete, and then thinks
+ * before issuing the next one. The requests of a user are grouped in
+ * sessions, and the user abandons the session if a request is rejected,
+ * times out, or takes longer than its patience. The number of users can
+ * be changed over time, either with a schedule or with setUsers().
+ *
+ * Completions are learned from the signals emitted with the job as details
+ * (jobCompleted and timedOut by the servers, rejected and dropped by the
+ * load balancer).
+ */
+class ClosedLoopSource : public queueing::SourceBase, omnetpp::cListener
+{
+protected:
+    enum TimerKind { THINK, PATIENCE };
+
+    struct User {
+        long index;
+        omnetpp::cMessage* timer;
+        long jobId; /**< id of the outstanding request, or -1 if thinking */
+        long sessionId;
+        long remainingRequests; /**< in the session, negative if unbounded */
+        bool active; /**< false once the user is leaving the population */
+    };
+
+    /** a deque, so that the users can be referenced from their timers */
+    std::deque<User> users;
+    unsigned activeUsers;
+    long nextSessionId;
+    RequestClassMix requestClassMix;
+    JobDemandSampler demandSampler;
+
+    /** (time, users) changes of the population, in time order */
+    std::vector<std::pair<double, unsigned>> populationSchedule;
+    unsigned nextScheduleEntry;
+    omnetpp::cMessage* populationTimer;
+
+    omnetpp::simsignal_t activeUsersSignal;
+    omnetpp::simsignal_t abandonedSignal;
+    omnetpp::simsignal_t jobCompletedSignal;
+    omnetpp::simsignal_t timedOutSignal;
+    omnetpp::simsignal_t rejectedSignal;
+    omnetpp::simsignal_t droppedSignal;
+
+    /**
+     * Parses "time users, ..."
+     */
+    void parsePopulationSchedule(const char* schedule);
+
+    void issueRequest(User& user);
+    void think(User& user);
+    void abandon(User& user);
+
+    /**
+     * Handles the completion (or failure) of the request of a user
+     */
+    void requestFinished(omnetpp::cMessage* job, bool failed);
+
+    virtual void initialize();
+    virtual void handleMessage(omnetpp::cMessage *msg);
+
+public:
+    ClosedLoopSource();
+    virtual ~ClosedLoopSource();
+
+    /**
+     * Changes the number of users
+     *
+     * New users start thinking. Removed users leave right away if they are
+     * thinking, or when their outstanding request finishes.
+     */
+    void setUsers(unsigned count);
+    unsigned getUsers() const;
+
+    virtual void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, long value, omnetpp::cObject *details) override;
+};
+
+#endif /* CLOSEDLOOPSOURCE_H_ */
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_JOBATTRIBUTES_H_
+#define __PLASA_JOBATTRIBUTES_H_
+
+#include <omnetpp.h>
+
+/**
+ * Attributes attached to jobs by the sources
+ *
+ * queueing::Job cannot be extended without changing queueinglib, so the
+ * attributes are carried as message parameters. They are only added
+ * when the source is configured to generate them.
+ */
+namespace JobAttributes {
+
+const char* const SESSION_ID = "sessionId";
+
+inline void setSessionId(omnetpp::cMessage* msg, long sessionId) {
+    msg->addPar(SESSION_ID).setLongValue(sessionId);
+}
+
+/**
+ * @return true if the job has a session id, which is returned in sessionId
+ */
+inline bool getSessionId(omnetpp::cMessage* msg, long& sessionId) {
+    int index = msg->findPar(SESSION_ID);
+    if (index < 0) {
+        return false;
+    }
+    sessionId = msg->par(index).longValue();
+    return true;
+}
+
+const char* const USER_ID = "userId";
+
+inline void setUserId(omnetpp::cMessage* msg, long userId) {
+    msg->addPar(USER_ID).setLongValue(userId);
+}
+
+/**
+ * @return true if the job was issued by a user of a closed-loop source,
+ *   whose index is returned in userId
+ */
+inline bool getUserId(omnetpp::cMessage* msg, long& userId) {
+    int index = msg->findPar(USER_ID);
+    if (index < 0) {
+        return false;
+    }
+    userId = msg->par(index).longValue();
+    return true;
+}
+
+const char* const REQUEST_CLASS = "requestClass";
+
+inline void setRequestClass(omnetpp::cMessage* msg, long requestClass) {
+    msg->addPar(REQUEST_CLASS).setLongValue(requestClass);
+}
+
+/**
+ * @return the index of the request class of the job (see RequestClass),
+ *   or -1 if it has none
+ */
+inline long getRequestClass(omnetpp::cMessage* msg) {
+    int index = msg->findPar(REQUEST_CLASS);
+    return (index < 0) ? -1 : msg->par(index).longValue();
+}
+
+const char* const SERVICE_TIME = "serviceTime";
+const char* const LOW_FIDELITY_SERVICE_TIME = "lowFidelityServiceTime";
+const char* const DIMMER_UNIFORM = "dimmerUniform";
+
+/**
+ * Attaches the demands drawn when the job is created (see JobDemandSampler)
+ *
+ * @param dimmerUniform uniform in [0, 1) compared with the brownout factor
+ *   to decide whether the job is served with low fidelity
+ */
+inline void setDemands(omnetpp::cMessage* msg, double serviceTime, double lowFidelityServiceTime, double dimmerUniform) {
+    msg->addPar(SERVICE_TIME).setDoubleValue(serviceTime);
+    msg->addPar(LOW_FIDELITY_SERVICE_TIME).setDoubleValue(lowFidelityServiceTime);
+    msg->addPar(DIMMER_UNIFORM).setDoubleValue(dimmerUniform);
+}
+
+/**
+ * @return true if the job has demands drawn when it was created
+ */
+inline bool getDemands(omnetpp::cMessage* msg, double& serviceTime, double& lowFidelityServiceTime, double& dimmerUniform) {
+    int index = msg->findPar(SERVICE_TIME);
+    if (index < 0) {
+        return false;
+    }
+    serviceTime = msg->par(index).doubleValue();
+    lowFidelityServiceTime = msg->par(LOW_FIDELITY_SERVICE_TIME).doubleValue();
+    dimmerUniform = msg->par(DIMMER_UNIFORM).doubleValue();
+    return true;
+}
+
+const char* const REJECTING_QUEUE = "rejectingQueue";
+
+/**
+ * Sets the queue the job was rejected for, when it is rejected before
+ * reaching it (e.g., by the load balancer because the queue is full)
+ *
+ * @param queueId module id of the queue
+ */
+inline void setRejectingQueue(omnetpp::cMessage* msg, int queueId) {
+    msg->addPar(REJECTING_QUEUE).setLongValue(queueId);
+}
+
+/**
+ * @return the module id of the queue the job was rejected for, or -1 if
+ *   it has none
+ */
+inline int getRejectingQueue(omnetpp::cMessage* msg) {
+    int index = msg->findPar(REJECTING_QUEUE);
+    return (index < 0) ? -1 : (int) msg->par(index).longValue();
+}
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "JobDemandSampler.h"
+#include "JobAttributes.h"
+#include "RequestClass.h"
+
+using namespace omnetpp;
+
+/* same as the brownout decision in MTBrownoutServer */
+const int BROWNOUT_RNG = 2;
+
+JobDemandSampler::JobDemandSampler() : pSource(nullptr) {
+}
+
+void JobDemandSampler::initialize(cSimpleModule* pSource) {
+    if (pSource->par("commonRandomNumbers").boolValue()) {
+        this->pSource = pSource;
+    }
+}
+
+bool JobDemandSampler::isEnabled() const {
+    return pSource != nullptr;
+}
+
+void JobDemandSampler::sample(cMessage* job) {
+    cComponent* pDistributions = pSource;
+    long requestClass = JobAttributes::getRequestClass(job);
+    if (requestClass >= 0) {
+        pDistributions = RequestClass::get(requestClass);
+    }
+    if (pDistributions == nullptr) {
+        return;
+    }
+
+    /*
+     * all the servers (and classes) use the same RNG for the service times,
+     * and they do not draw from it when the jobs bring their demands
+     */
+    double serviceTime = pDistributions->par("serviceTime").doubleValue();
+    double lowFidelityServiceTime = pDistributions->par("lowFidelityServiceTime").doubleValue();
+    double dimmerUniform = pSource->uniform(0, 1, BROWNOUT_RNG);
+    JobAttributes::setDemands(job, serviceTime, lowFidelityServiceTime, dimmerUniform);
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_JOBDEMANDSAMPLER_H_
+#define __PLASA_JOBDEMANDSAMPLER_H_
+
+#include <omnetpp.h>
+
+/**
+ * Draws the random demands of a job when it is created (common random numbers)
+ *
+ * Normally, the servers draw the service time and the uniform that decides
+ * whether a request is served with low fidelity when they start serving the
+ * job, so two runs in which the same request is routed or dimmed differently
+ * get different demands. With this, the source draws them for every job in
+ * arrival order, and stores them in the job (see JobAttributes), so that
+ * runs with different adaptation managers see the same demands.
+ *
+ * The distributions are the ones of the request class of the job, or else
+ * the serviceTime and lowFidelityServiceTime parameters of the source, which
+ * are normally set to the same distributions as the servers.
+ */
+class JobDemandSampler {
+    omnetpp::cComponent* pSource;
+
+public:
+    JobDemandSampler();
+
+    /**
+     * @param pSource source that creates the jobs
+     */
+    void initialize(omnetpp::cSimpleModule* pSource);
+
+    bool isEnabled() const;
+
+    /**
+     * Draws the demands of the job, and attaches them to it
+     */
+    void sample(omnetpp::cMessage* job);
+};
+
+#endif
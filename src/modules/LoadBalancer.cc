@@ -0,0 +1,416 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "LoadBalancer.h"
+#include "ServerQueue.h"
+#include "MTServer.h"
+#include "JobAttributes.h"
+#include "Job.h"
+#include <cmath>
+#include <model/Model.h>
+#include <managers/execution/ExecutionManagerMod.h>
+
+using namespace omnetpp;
+
+Define_Module(LoadBalancer);
+
+#define RNG 3
+
+namespace {
+
+/**
+ * 64-bit FNV-1a hash, so that the ring is the same across platforms
+ */
+uint64_t hashString(const char* str, uint64_t seed) {
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+    while (*str) {
+        hash ^= (unsigned char) *str++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * splitmix64 finalizer, used to spread the keys uniformly on the ring
+ */
+uint64_t hashKey(uint64_t key) {
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+}
+
+LoadBalancer::LoadBalancer() : routingAlgorithm(ROUND_ROBIN), choices(2), rrCounter(-1),
+        virtualNodes(0), loadBound(0), ringVersion(0), queueCapacity(-1), admissionBurst(1), stealingPolicy(NO_STEALING),
+        stealCount(0), stolenJobCount(0), pRegistry(nullptr), pModel(nullptr) {}
+
+void LoadBalancer::initialize()
+{
+    const char *algName = par("routingAlgorithm");
+    if (strcmp(algName, "roundRobin") == 0) {
+        routingAlgorithm = ROUND_ROBIN;
+    } else if (strcmp(algName, "shortestQueue") == 0) {
+        routingAlgorithm = SHORTEST_QUEUE;
+    } else if (strcmp(algName, "leastWork") == 0) {
+        routingAlgorithm = LEAST_WORK;
+    } else if (strcmp(algName, "powerOfD") == 0) {
+        routingAlgorithm = POWER_OF_D;
+    } else if (strcmp(algName, "weightedRoundRobin") == 0) {
+        routingAlgorithm = WEIGHTED_ROUND_ROBIN;
+    } else if (strcmp(algName, "consistentHash") == 0) {
+        routingAlgorithm = CONSISTENT_HASH;
+    } else {
+        error("invalid routing algorithm '%s'", algName);
+    }
+
+    choices = par("choices");
+    if (choices < 1) {
+        error("choices must be at least 1");
+    }
+    rrCounter = -1;
+
+    virtualNodes = par("virtualNodes");
+    if (virtualNodes < 1) {
+        error("virtualNodes must be at least 1");
+    }
+    loadBound = par("loadBound");
+    if (loadBound != 0 && loadBound < 1) {
+        error("loadBound must be 0 (unbounded) or at least 1");
+    }
+
+    queueCapacity = par("queueCapacity");
+    admissionBurst = par("admissionBurst");
+    if (admissionBurst < 1) {
+        error("admissionBurst must be at least 1");
+    }
+    admission.setRate(par("admissionRate"), admissionBurst);
+    rejectedSignal = registerSignal("rejected");
+
+    const char *stealingName = par("stealing");
+    if (strcmp(stealingName, "none") == 0) {
+        stealingPolicy = NO_STEALING;
+    } else if (strcmp(stealingName, "random") == 0) {
+        stealingPolicy = STEAL_RANDOM;
+    } else if (strcmp(stealingName, "longest") == 0) {
+        stealingPolicy = STEAL_LONGEST;
+    } else if (strcmp(stealingName, "half") == 0) {
+        stealingPolicy = STEAL_HALF;
+    } else {
+        error("invalid stealing policy '%s'", stealingName);
+    }
+
+    threadAvailableSignal = registerSignal("threadAvailable");
+    stealSignal = registerSignal("steal");
+    stolenWorkSignal = registerSignal("stolenWork");
+    if (stealingPolicy != NO_STEALING) {
+        getSimulation()->getSystemModule()->subscribe(threadAvailableSignal, this);
+    }
+
+    pModel = check_and_cast<Model*>(getParentModule()->getSubmodule("model"));
+    pRegistry = &(check_and_cast<ExecutionManagerMod*>(
+            getParentModule()->getSubmodule("executionManager"))->getServerRegistry());
+}
+
+void LoadBalancer::handleMessage(cMessage *msg)
+{
+    if (!admission.admit()) {
+        emit(rejectedSignal, 1L, msg);
+        delete msg;
+        return;
+    }
+
+    int outGateIndex = selectServer(msg);
+
+    // send out if the index is legal
+    if (outGateIndex < 0 || outGateIndex >= gateSize("out")) {
+        throw cRuntimeError("Invalid output gate selected during routing");
+    }
+
+    // reject instead of queueing if the queue of the selected server is full
+    ServerQueue* pQueue = (*pRegistry)[outGateIndex].pQueue;
+    if (queueCapacity >= 0 && pQueue->length() >= queueCapacity) {
+        admission.refund();
+        JobAttributes::setRejectingQueue(msg, pQueue->getId()); // counted for the server
+        emit(rejectedSignal, 1L, msg);
+        delete msg;
+        return;
+    }
+
+    send(msg, "out", outGateIndex);
+}
+
+void LoadBalancer::setAdmissionRate(double rate) {
+    Enter_Method("setAdmissionRate()");
+    admission.setRate(rate, admissionBurst);
+}
+
+double LoadBalancer::getAdmissionRate() const {
+    return admission.getRate();
+}
+
+int LoadBalancer::selectServer(cMessage *msg) {
+    unsigned servers = pRegistry->size();
+    ASSERT(servers == (unsigned) gateSize("out"));
+    if (servers == 0) {
+        return -1;
+    }
+
+    switch (routingAlgorithm) {
+    case SHORTEST_QUEUE:
+        return selectShortestQueue(servers);
+    case LEAST_WORK:
+        return selectLeastWork(servers);
+    case POWER_OF_D:
+        return selectPowerOfD(servers);
+    case WEIGHTED_ROUND_ROBIN:
+        return selectWeightedRoundRobin(servers);
+    case CONSISTENT_HASH:
+        return selectConsistentHash(servers, msg);
+    default:
+        return selectRoundRobin(servers);
+    }
+}
+
+int LoadBalancer::selectRoundRobin(unsigned servers) {
+    rrCounter = (rrCounter + 1) % servers;
+    return rrCounter;
+}
+
+int LoadBalancer::selectShortestQueue(unsigned servers) {
+
+    /*
+     * start the scan after the last selected server, so that ties are
+     * broken in round robin order instead of always favoring the first server
+     */
+    unsigned start = (rrCounter + 1) % servers;
+    int best = start;
+    unsigned bestJobs = pRegistry->getJobCount(start);
+    for (unsigned i = 1; i < servers && bestJobs > 0; i++) {
+        unsigned index = (start + i) % servers;
+        unsigned jobs = pRegistry->getJobCount(index);
+        if (jobs < bestJobs) {
+            best = index;
+            bestJobs = jobs;
+        }
+    }
+    rrCounter = best;
+    return best;
+}
+
+double LoadBalancer::getExpectedJobWork() const {
+    double brownoutFactor = pModel->getBrownoutFactor();
+    return (1 - brownoutFactor) * pModel->getServiceTime()
+            + brownoutFactor * pModel->getLowFidelityServiceTime();
+}
+
+double LoadBalancer::getOutstandingWork(unsigned index) const {
+    const ServerRegistry::Entry& entry = (*pRegistry)[index];
+
+    /*
+     * the service time of queued jobs is not known until they start, so
+     * estimate it with the mean service time adjusted by the cache state
+     */
+    return entry.pServer->getOutstandingWork()
+            + entry.pQueue->length() * getExpectedJobWork() / entry.pServer->getRelativeSpeed();
+}
+
+int LoadBalancer::selectLeastWork(unsigned servers) {
+    unsigned start = (rrCounter + 1) % servers;
+    int best = start;
+    double bestWork = getOutstandingWork(start);
+    for (unsigned i = 1; i < servers; i++) {
+        unsigned index = (start + i) % servers;
+        double work = getOutstandingWork(index);
+        if (work < bestWork) {
+            best = index;
+            bestWork = work;
+        }
+    }
+    rrCounter = best;
+    return best;
+}
+
+int LoadBalancer::selectPowerOfD(unsigned servers) {
+    if (choices >= servers) {
+        return selectShortestQueue(servers);
+    }
+
+    // sample d distinct servers (d is small, so rejection is cheap)
+    sampled.clear();
+    int best = -1;
+    unsigned bestJobs = 0;
+    while (sampled.size() < choices) {
+        unsigned index = intuniform(0, servers - 1, RNG);
+        if (std::find(sampled.begin(), sampled.end(), index) != sampled.end()) {
+            continue;
+        }
+        sampled.push_back(index);
+
+        unsigned jobs = pRegistry->getJobCount(index);
+        if (best < 0 || jobs < bestJobs) {
+            best = index;
+            bestJobs = jobs;
+        }
+    }
+    return best;
+}
+
+int LoadBalancer::selectWeightedRoundRobin(unsigned servers) {
+    if (currentWeights.size() != servers) {
+        currentWeights.assign(servers, 0.0);
+    }
+
+    int best = 0;
+    double totalWeight = 0;
+    for (unsigned index = 0; index < servers; index++) {
+        double weight = (*pRegistry)[index].pServer->getRelativeSpeed();
+        currentWeights[index] += weight;
+        totalWeight += weight;
+        if (currentWeights[index] > currentWeights[best]) {
+            best = index;
+        }
+    }
+    currentWeights[best] -= totalWeight;
+    return best;
+}
+
+void LoadBalancer::buildRing() {
+    ring.clear();
+    ring.reserve(pRegistry->size() * virtualNodes);
+    for (unsigned index = 0; index < pRegistry->size(); index++) {
+        const char* name = getSimulation()->getModule((*pRegistry)[index].moduleId)->getName();
+        for (unsigned v = 0; v < virtualNodes; v++) {
+            ring.push_back(std::make_pair(hashString(name, hashKey(v)), index));
+        }
+    }
+    std::sort(ring.begin(), ring.end());
+    ringVersion = pRegistry->getVersion();
+}
+
+int LoadBalancer::selectConsistentHash(unsigned servers, cMessage *msg) {
+    if (ring.empty() || ringVersion != pRegistry->getVersion()) {
+        buildRing();
+    }
+
+    // requests without a session have no affinity, so any key will do
+    long sessionId;
+    if (!JobAttributes::getSessionId(msg, sessionId)) {
+        sessionId = msg->getId();
+    }
+    uint64_t key = hashKey(sessionId);
+
+    auto it = std::lower_bound(ring.begin(), ring.end(), std::make_pair(key, 0u));
+    if (it == ring.end()) {
+        it = ring.begin();
+    }
+    if (loadBound == 0) {
+        return it->second;
+    }
+
+    /*
+     * consistent hashing with bounded loads: walk the ring clockwise
+     * until finding a server whose load (including this request) does not
+     * exceed loadBound times the average. There is always one, because
+     * not all servers can be above the average
+     */
+    unsigned totalJobs = 1;
+    for (unsigned index = 0; index < servers; index++) {
+        totalJobs += pRegistry->getJobCount(index);
+    }
+    unsigned capacity = ceil(loadBound * totalJobs / servers);
+    for (unsigned i = 0; i < ring.size(); i++) {
+        if (pRegistry->getJobCount(it->second) + 1 <= capacity) {
+            return it->second;
+        }
+        if (++it == ring.end()) {
+            it = ring.begin();
+        }
+    }
+
+    // not reachable with loadBound >= 1
+    return selectShortestQueue(servers);
+}
+
+void LoadBalancer::steal(unsigned thief) {
+    unsigned servers = pRegistry->size();
+    if (servers < 2) {
+        return;
+    }
+
+    int victim = -1;
+    if (stealingPolicy == STEAL_RANDOM) {
+        victim = intuniform(0, servers - 2, RNG);
+        if (victim >= (int) thief) {
+            victim++; // skip the thief
+        }
+    } else {
+        int longest = 0;
+        for (unsigned index = 0; index < servers; index++) {
+            int length = (*pRegistry)[index].pQueue->length();
+            if (index != thief && length > longest) {
+                victim = index;
+                longest = length;
+            }
+        }
+    }
+    if (victim < 0) {
+        return;
+    }
+
+    ServerQueue* pVictimQueue = (*pRegistry)[victim].pQueue;
+    int jobs = pVictimQueue->length();
+    if (jobs == 0) {
+        return;
+    }
+    if (stealingPolicy == STEAL_HALF) {
+        jobs = std::max(jobs / 2, 1);
+    } else {
+        jobs = 1;
+    }
+
+    for (int i = 0; i < jobs; i++) {
+
+        // the oldest jobs are taken, which are the ones that would wait the longest
+        queueing::Job* job = pVictimQueue->steal();
+        take(job);
+        send(job, "out", thief);
+    }
+
+    stealCount++;
+    stolenJobCount += jobs;
+    emit(stealSignal, (long) jobs);
+    emit(stolenWorkSignal, jobs * getExpectedJobWork());
+}
+
+void LoadBalancer::receiveSignal(cComponent *source, simsignal_t signalID, bool value, cObject *details) {
+    if (signalID == threadAvailableSignal) {
+
+        // servers being removed are no longer in the registry, so they don't steal
+        int thief = pRegistry->find(source->getParentModule()->getId());
+        if (thief >= 0) {
+            Enter_Method_Silent("receiveSignal()");
+            steal(thief);
+        }
+    }
+}
+
+void LoadBalancer::finish() {
+    if (stealingPolicy != NO_STEALING) {
+        recordScalar("steals", stealCount);
+        recordScalar("stolenJobs", stolenJobCount);
+    }
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_LOADBALANCER_H_
+#define __PLASA_LOADBALANCER_H_
+
+#include <omnetpp.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "ServerRegistry.h"
+#include <util/TokenBucket.h>
+
+class Model;
+
+/**
+ * Load balancer that can use the state of the servers to route requests
+ *
+ * The state of the servers is read from the ServerRegistry maintained by
+ * the execution manager. Output gate i is connected to server i in the registry.
+ */
+class LoadBalancer : public omnetpp::cSimpleModule, omnetpp::cListener
+{
+  public:
+    enum RoutingAlgorithm {
+        ROUND_ROBIN,
+        SHORTEST_QUEUE, /**< join the server with the fewest jobs (queued + running) */
+        LEAST_WORK, /**< join the server with the least outstanding work */
+        POWER_OF_D, /**< shortest queue among d servers chosen at random */
+        WEIGHTED_ROUND_ROBIN, /**< smooth weighted round robin using the relative speed of the servers */
+        CONSISTENT_HASH /**< session affinity using a hash ring with virtual nodes and bounded loads */
+    };
+
+    enum StealingPolicy {
+        NO_STEALING,
+        STEAL_RANDOM, /**< steal one job from a server chosen at random */
+        STEAL_LONGEST, /**< steal one job from the server with the longest queue */
+        STEAL_HALF /**< steal half of the jobs from the server with the longest queue */
+    };
+
+  protected:
+    RoutingAlgorithm routingAlgorithm;
+    unsigned choices; /**< d for the power of d choices policy */
+    int rrCounter;
+    std::vector<double> currentWeights; /**< state of the smooth weighted round robin */
+    std::vector<unsigned> sampled;
+
+    unsigned virtualNodes; /**< points per server in the hash ring */
+    double loadBound; /**< max load of a server relative to the average for consistentHash */
+
+    /**
+     * hash ring sorted by hash. Each point maps to a server index.
+     */
+    std::vector<std::pair<uint64_t, unsigned>> ring;
+    unsigned ringVersion; /**< version of the server registry the ring was built for */
+
+    int queueCapacity; /**< max jobs queued in a server before requests are rejected (negative for no limit) */
+    double admissionBurst;
+    TokenBucket admission;
+    omnetpp::simsignal_t rejectedSignal;
+
+    StealingPolicy stealingPolicy;
+    omnetpp::simsignal_t threadAvailableSignal;
+    omnetpp::simsignal_t stealSignal;
+    omnetpp::simsignal_t stolenWorkSignal;
+    long stealCount;
+    long stolenJobCount;
+
+    const ServerRegistry* pRegistry;
+    Model* pModel;
+
+    virtual void initialize();
+    virtual void handleMessage(omnetpp::cMessage *msg);
+    virtual void finish();
+
+    /**
+     * @return index of the output gate (and server) to send the next request to
+     */
+    virtual int selectServer(omnetpp::cMessage *msg);
+
+    int selectRoundRobin(unsigned servers);
+    int selectShortestQueue(unsigned servers);
+    int selectLeastWork(unsigned servers);
+    int selectPowerOfD(unsigned servers);
+    int selectWeightedRoundRobin(unsigned servers);
+    int selectConsistentHash(unsigned servers, omnetpp::cMessage *msg);
+
+    /**
+     * Builds the hash ring for the servers currently in the registry
+     *
+     * The points of a server only depend on its name, so when the pool
+     * changes only the keys of the servers added or removed are remapped.
+     */
+    void buildRing();
+
+    /**
+     * Estimates the work (in seconds of service) of a job that has not started
+     */
+    double getExpectedJobWork() const;
+
+    /**
+     * Estimates the work (in seconds of service) the server has pending
+     */
+    double getOutstandingWork(unsigned index) const;
+
+    /**
+     * Moves jobs from the queue of another server to the given server,
+     * according to the stealing policy
+     *
+     * @param thief index of the server that has an idle thread and no jobs queued
+     */
+    void steal(unsigned thief);
+
+  public:
+    LoadBalancer();
+
+    /**
+     * Limits the rate of requests admitted. Requests above the rate are rejected
+     *
+     * @param rate requests per second (0 for no limit)
+     */
+    void setAdmissionRate(double rate);
+    double getAdmissionRate() const;
+
+    virtual void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, bool value, omnetpp::cObject *details) override;
+};
+
+#endif
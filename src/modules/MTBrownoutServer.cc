@@ -15,6 +15,8 @@
 
 #include "MTBrownoutServer.h"
 #include "Job.h"
+#include "JobAttributes.h"
+#include <util/Utils.h>
 
 Define_Module(MTBrownoutServer);
 
@@ -41,9 +43,11 @@ Define_Module(MTBrownoutServer);
 
 std::map<std::string, long> MTBrownoutServer::requestCount;
 
+MTBrownoutServer::MTBrownoutServer() : pRequestCount(nullptr) {}
+
 void MTBrownoutServer::clearServerCache() {
     if (cacheClearsWhenReboot) {
-        requestCount[this->getParentModule()->getName()] = 0;
+        *pRequestCount = 0;
     }
 }
 
@@ -56,21 +60,54 @@ void MTBrownoutServer::initialize() {
     cacheDeltaLow = par("cacheDeltaLow");
     cachePrecision = par("cachePrecision");
     cacheClearsWhenReboot = par("cacheClearsWhenReboot");
+
+    /* note that this assumes that this module is inside an AppServer module with a unique name */
+    pRequestCount = &requestCount[this->getParentModule()->getName()];
+
+    meanServiceTime = Utils::getMeanAndVarianceFromParameter(par("serviceTime"));
+    meanLowFidelityServiceTime = Utils::getMeanAndVarianceFromParameter(par("lowFidelityServiceTime"));
+
+    unsigned classCount = RequestClass::getCount();
+    for (unsigned c = 0; c < classCount; c++) {
+        requestClasses.push_back(RequestClass::get(c));
+    }
 }
 
 simtime_t MTBrownoutServer::generateJobServiceTime(queueing::Job* pJob)  {
-    double brownoutFactor = par("brownoutFactor");
-    double u = uniform(0, 1, RNG);
+    RequestClass* pClass = nullptr;
+    long requestClass = JobAttributes::getRequestClass(pJob);
+    if (requestClass >= 0) {
+        if (requestClass >= (long) requestClasses.size()) {
+            error("job has request class %ld, but there are only %u classes", requestClass, (unsigned) requestClasses.size());
+        }
+        pClass = requestClasses[requestClass];
+    }
+
+    // the demands may have been drawn when the job was created (common random numbers)
+    double serviceTimeDemand, lowFidelityServiceTimeDemand, u;
+    bool predrawn = JobAttributes::getDemands(pJob, serviceTimeDemand, lowFidelityServiceTimeDemand, u);
+
+    double brownoutFactor = (pClass) ? pClass->getBrownoutFactor() : par("brownoutFactor").doubleValue();
+    if (!predrawn) {
+        u = uniform(0, 1, RNG);
+    }
     simtime_t st = 0;
     if (u > brownoutFactor) {
-        st = MTServer::generateJobServiceTime(pJob);
+        if (predrawn) {
+            st = serviceTimeDemand;
+        } else {
+            st = (pClass) ? pClass->generateServiceTime(false) : MTServer::generateJobServiceTime(pJob);
+        }
     } else {
         pJob->setKind(1); // mark the job as low fidelity
-        simtime_t serviceTime = par("lowFidelityServiceTime");
-        if (serviceTime <= 0.0) {
-            serviceTime = 0.000001; // make it a very short job
+        if (predrawn) {
+            st = lowFidelityServiceTimeDemand;
+        } else {
+            st = (pClass) ? pClass->generateServiceTime(true) : par("lowFidelityServiceTime").doubleValue();
         }
-        st = serviceTime;
+    }
+    if (st <= 0.0) {
+        st = 0.000001; // make it a very short job
     }
 
 #if CACHING_EFFECT
@@ -80,10 +117,9 @@ simtime_t MTBrownoutServer::generateJobServiceTime(queueing::Job* pJob)  {
         double delta = (pJob->getKind() == 1) ? cacheDeltaLow : cacheDelta;
         double lambda = (-1.0 / cacheRequestCount) * (log(cachePrecision * delta) - log(delta));
 
-        /* note that this assumes that this module is inside an AppServer module with a unique name */
-        long myRequestCount = requestCount[this->getParentModule()->getName()];
+        long myRequestCount = *pRequestCount;
         st += delta * exp(-lambda * myRequestCount);
-        requestCount[this->getParentModule()->getName()] = ++myRequestCount;
+        *pRequestCount = ++myRequestCount;
     }
 #endif
 
@@ -91,3 +127,21 @@ simtime_t MTBrownoutServer::generateJobServiceTime(queueing::Job* pJob)  {
 
     return st;
 }
+
+double MTBrownoutServer::getRelativeSpeed() const {
+#if CACHING_EFFECT
+    double brownoutFactor = par("brownoutFactor");
+    double warmServiceTime = (1 - brownoutFactor) * meanServiceTime + brownoutFactor * meanLowFidelityServiceTime;
+
+    // the decay rate is the same for both kinds of requests (see generateJobServiceTime())
+    double decay = exp(log(cachePrecision) / cacheRequestCount * *pRequestCount);
+    double coldPenalty = (1 - brownoutFactor) * cacheDelta * decay;
+    if (cacheLow) {
+        coldPenalty += brownoutFactor * cacheDeltaLow * decay;
+    }
+    if (warmServiceTime > 0) {
+        return warmServiceTime / (warmServiceTime + coldPenalty);
+    }
+#endif
+    return 1.0;
+}
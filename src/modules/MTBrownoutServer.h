@@ -19,6 +19,8 @@
 #include "MTServer.h"
 #include <map>
 #include <string>
+#include <vector>
+#include "RequestClass.h"
 
 /**
  * Module class for a multi-threaded server with brownout
@@ -34,6 +36,19 @@ class MTBrownoutServer : public MTServer
      */
     static std::map<std::string, long> requestCount;
 
+    /**
+     * Entry of requestCount for this server. It is looked up once at
+     * initialization so that it stays the same after the server is
+     * renamed for removal.
+     */
+    long* pRequestCount;
+
+    /**
+     * Mean service time without caching effects, used to compute
+     * the relative speed of the server
+     */
+    double meanServiceTime;
+    double meanLowFidelityServiceTime;
 
     /**
      * Low service requests use DB much less, so caching is not that important
@@ -76,12 +91,25 @@ class MTBrownoutServer : public MTServer
      */
     bool cacheClearsWhenReboot;
 
+    /**
+     * Request classes of the network (empty if there are none), which
+     * override the service times and the brownout factor of the server
+     */
+    std::vector<RequestClass*> requestClasses;
+
   protected:
     virtual simtime_t generateJobServiceTime(queueing::Job* pJob);
     virtual void initialize() override;
 
   public:
+    MTBrownoutServer();
     void clearServerCache();
+
+    /**
+     * Ratio between the expected service time of a warm server and
+     * the expected service time of this server given its cache state
+     */
+    virtual double getRelativeSpeed() const override;
 };
 
 #endif
@@ -22,11 +22,19 @@ Define_Module(MTServer);
 
 using namespace queueing;
 
-MTServer::MTServer() : endExecutionMsg(NULL), selectionStrategy(NULL), maxThreads(0) {}
+MTServer::MTServer() : endExecutionMsg(NULL), selectionStrategy(NULL), maxThreads(0), incomingJobs(0), outstandingWork(0) {}
 
 void MTServer::initialize() {
     busySignal = registerSignal("busy");
+    threadAvailableSignal = registerSignal("threadAvailable");
+    timedOutSignal = registerSignal("timedOut");
+    jobQueueTimeSignal = registerSignal("jobQueueTime");
+    jobServiceDemandSignal = registerSignal("jobServiceDemand");
+    jobSlowdownSignal = registerSignal("jobSlowdown");
+    runningJobsSignal = registerSignal("runningJobs");
+    jobCompletedSignal = registerSignal("jobCompleted");
     emit(busySignal, false);
+    emit(runningJobsSignal, 0L);
     maxThreads = par("threads");
     endExecutionMsg = new cMessage("end-execution");
     selectionStrategy = SelectionStrategy::create(par("fetchingAlgorithm"), this, true);
@@ -52,30 +60,41 @@ void MTServer::handleMessage(cMessage* msg) {
         // send out all jobs that completed
         RunningJobs::iterator first = runningJobs.begin();
         while (first != runningJobs.end() && first->remainingServiceTime < 1e-10) {
+            outstandingWork -= first->remainingServiceTime;
+            emitJobTimes(*first);
+            emit(jobCompletedSignal, (long) first->pJob->getKind(), first->pJob);
             send(first->pJob, "out");
             runningJobs.erase(first);
             first = runningJobs.begin();
         };
+        emit(runningJobsSignal, (long) runningJobs.size());
 
         if (!runningJobs.empty()) {
             scheduleNextCompletion();
         } else {
+            outstandingWork = 0; // don't let rounding errors accumulate
             emit(busySignal, false);
             if (hasGUI()) getDisplayString().setTagArg("i",1,"");
         }
     }
     else
     {
-        if (!isIdle())
+        if (incomingJobs > 0) {
+            incomingJobs--;
+        }
+        if (runningJobs.size() >= maxThreads)
             error("job arrived while already full");
 
         ScheduledJob job;
         job.pJob = check_and_cast<Job *>(msg);
         if (timeout > 0 && job.pJob->getTotalQueueingTime() >= timeout) {
-            // don't serve this job, just send it out
-            send(job.pJob, "out");
+            // don't serve this job, and don't let the sink count it as served
+            emit(timedOutSignal, 1L, job.pJob);
+            delete job.pJob;
         } else {
             job.remainingServiceTime = generateJobServiceTime(job.pJob).dbl();
+            job.serviceDemand = job.remainingServiceTime;
+            job.startTime = simTime();
 
             // these two are nops if there was no job running
             updateJobTimes();
@@ -83,6 +102,8 @@ void MTServer::handleMessage(cMessage* msg) {
 
             runningJobs.push_back(job);
             runningJobs.sort();
+            outstandingWork += job.remainingServiceTime;
+            emit(runningJobsSignal, (long) runningJobs.size());
             scheduleNextCompletion();
 
             if (runningJobs.size() == 1) { // going from idle to busy
@@ -93,7 +114,7 @@ void MTServer::handleMessage(cMessage* msg) {
     }
 
 
-    if (runningJobs.size() < maxThreads) {
+    if (isIdle()) {
 
         // examine all input queues, and request a new job from a non empty queue
         int k = selectionStrategy->select();
@@ -102,6 +123,9 @@ void MTServer::handleMessage(cMessage* msg) {
             EV << "requesting job from queue " << k << endl;
             cGate *gate = selectionStrategy->selectableGate(k);
             check_and_cast<IPassiveQueue *>(gate->getOwnerModule())->request(gate->getIndex());
+        } else {
+            // let queues outside of this server (e.g., CentralQueue) know it can take a job
+            emit(threadAvailableSignal, true);
         }
     }
 }
@@ -112,6 +136,12 @@ void MTServer::scheduleNextCompletion() {
     scheduleAt(simTime() + first->remainingServiceTime * runningJobs.size(), endExecutionMsg);
 }
 
+void MTServer::emitJobTimes(const ScheduledJob& job) {
+    emit(jobQueueTimeSignal, job.pJob->getTotalQueueingTime().dbl(), job.pJob);
+    emit(jobServiceDemandSignal, job.serviceDemand, job.pJob);
+    emit(jobSlowdownSignal, (simTime() - job.startTime).dbl() / job.serviceDemand, job.pJob);
+}
+
 void MTServer::updateJobTimes() {
     simtime_t d = simTime() - endExecutionMsg->getSendingTime();
 
@@ -120,6 +150,11 @@ void MTServer::updateJobTimes() {
         it->remainingServiceTime -= d.dbl() / runningJobs.size();
         it->pJob->setTotalServiceTime(it->pJob->getTotalServiceTime() + d);
     }
+
+    // the processor is shared, so the total work decreases at rate 1
+    if (!runningJobs.empty()) {
+        outstandingWork -= d.dbl();
+    }
 }
 
 void MTServer::finish() {
@@ -134,9 +169,18 @@ simtime_t MTServer::generateJobServiceTime(queueing::Job*) {
 }
 
 bool MTServer::isIdle() {
-    return runningJobs.size() < maxThreads;
+    return getIdleThreadCount() > 0;
 }
 
 bool MTServer::isEmpty() {
-    return runningJobs.size() == 0;
+    return runningJobs.size() == 0 && incomingJobs == 0;
+}
+
+void MTServer::reserveThread() {
+    ASSERT(isIdle());
+    incomingJobs++;
+}
+
+double MTServer::getRelativeSpeed() const {
+    return 1.0;
 }
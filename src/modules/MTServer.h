@@ -29,6 +29,8 @@ protected:
     struct ScheduledJob {
         queueing::Job* pJob;
         double remainingServiceTime; // as if it was not sharing the processor
+        double serviceDemand; // service time as if it was not sharing the processor
+        omnetpp::simtime_t startTime;
         bool operator<(const ScheduledJob& b) const {
             return remainingServiceTime < b.remainingServiceTime;
         }
@@ -38,14 +40,36 @@ protected:
     queueing::SelectionStrategy* selectionStrategy;
     unsigned maxThreads;
     simsignal_t busySignal;
+    simsignal_t threadAvailableSignal;
+    simsignal_t timedOutSignal;
+    simsignal_t jobQueueTimeSignal;
+    simsignal_t jobServiceDemandSignal;
+    simsignal_t jobSlowdownSignal;
+    simsignal_t runningJobsSignal;
+    simsignal_t jobCompletedSignal;
 
     typedef std::list<ScheduledJob> RunningJobs;
     RunningJobs runningJobs;
     simtime_t timeout;
 
+    /** jobs sent to this server that have not arrived yet (see reserveThread()) */
+    unsigned incomingJobs;
+
+    /**
+     * Sum of the remaining service time of the running jobs, kept up to date
+     * incrementally so that load balancers can read it in O(1)
+     */
+    double outstandingWork;
+
     virtual void updateJobTimes();
     virtual void scheduleNextCompletion();
 
+    /**
+     * Emits the queueing time, service demand and processor sharing slowdown
+     * of a completed job (with the job as the signal details)
+     */
+    virtual void emitJobTimes(const ScheduledJob& job);
+
     virtual simtime_t generateJobServiceTime(queueing::Job* pJob);
 
     virtual void initialize();
@@ -62,6 +86,42 @@ public:
     virtual bool isIdle();
 
     virtual bool isEmpty();
+
+    /**
+     * Takes a thread for a job that is being sent to this server
+     *
+     * The server only sees a job when it arrives, so the queue that sends
+     * it calls this to keep the thread from being offered again in the
+     * meantime (e.g., to another job sent at the same time).
+     */
+    void reserveThread();
+
+    /**
+     * @return threads that are neither running a job nor reserved
+     */
+    unsigned getIdleThreadCount() const {
+        return maxThreads - runningJobs.size() - incomingJobs;
+    }
+
+    unsigned getRunningJobCount() const {
+        return runningJobs.size();
+    }
+
+    /**
+     * Returns the service time still needed to complete the running jobs
+     * (as if they were executed one at a time)
+     */
+    double getOutstandingWork() const {
+        return outstandingWork;
+    }
+
+    /**
+     * Speed of this server relative to a fully warmed up server.
+     * Used as the weight for weighted load balancing policies.
+     *
+     * @return value in (0,1]
+     */
+    virtual double getRelativeSpeed() const;
 };
 
 #endif /* MTSERVER_H_ */
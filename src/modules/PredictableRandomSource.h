@@ -18,13 +18,15 @@
 
 #include "PredictableSource.h"
 
-#define WORST_CASE 0 // attempt to create WC conditions
-
-#if WORST_CASE
-#include <vector>
-#endif
-
+/**
+ * Generates arrivals with a random rate that changes every period
+ *
+ * Arrivals are generated as they are needed, either to be scheduled or for
+ * predictions up to the lookahead, and the ones already consumed are
+ * discarded, so the memory used does not grow with the length of the run.
+ */
 class PredictableRandomSource: public PredictableSource {
+    double periodLength; /**< the rate changes every period */
     double timeInPeriod;
     double lastArrivalTime;
     double mean;
@@ -32,17 +34,16 @@ class PredictableRandomSource: public PredictableSource {
     double maxRate;
     double rate;
     int direction; // -1 down, 0 none, 1 up
-#if WORST_CASE
-    std::vector<double> rateSequence;
-    int seqIndex;
-#endif
 protected:
+  virtual void readTraceParameters() {} // the arrivals are generated
   virtual void preload();
   virtual bool generateArrival();
   virtual void initialize();
 
 public:
   virtual double getPrediction(double startDelta, double windowDuration, double* pVariance, bool debug = false);
+  virtual void getPredictions(double startDelta, double windowDuration, unsigned windows,
+          std::vector<double>& means, std::vector<double>* pVariances = nullptr);
 
     double getMaxRate() const {
         return maxRate;
@@ -51,7 +51,6 @@ void PredictableRateSource::preload() {
                 duration -= timeValue;
                 arrivalTime += timeValue;
                 arrivalTimes.push_back(arrivalTime);
-                interArrivalTimes.push_back(timeValue);
             }
         }
         fin.close();
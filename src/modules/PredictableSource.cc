@@ -15,24 +15,48 @@
 
 #include "PredictableSource.h"
 #include "Job.h"
+#include "JobAttributes.h"
 #include <iostream>
 #include <fstream>
 #include <cmath>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/moment.hpp>
+#include <algorithm>
+#include <stdexcept>
 
 
 Define_Module(PredictableSource);
 
-using namespace boost::accumulators;
 using namespace std;
 
+const int SESSION_RNG = 4;
+const int REQUEST_CLASS_RNG = 5;
+
+void PredictableSource::readTraceParameters() {
+    scale = par("scale").doubleValue();
+}
+
 void PredictableSource::preload() {
     double arrivalTime = 0;
     const char* filePath = par("interArrivalsFile").stringValue();
-    double skip = par("skip").doubleValue();
+    skip = par("skip").doubleValue();
+
+    if (BinaryTrace::isBinaryTrace(filePath)) {
+        mapTrace(filePath);
+        return;
+    }
+
+    if (par("streamTrace").boolValue()) {
+        lookahead = par("lookahead").doubleValue();
+        try {
+            streamReader.reset(new TraceStreamReader(filePath, par("streamChunkSize").intValue(),
+                    par("streamBuffers").intValue()));
+        } catch (const std::exception& e) {
+            error("PredictableSource %s: %s", this->getFullName(), e.what());
+        }
+        boundedHistory = true;
+        streamArrivals(lookahead, true);
+        EV << "streaming " << filePath << endl;
+        return;
+    }
 
     ifstream fin(filePath);
     if (!fin) {
@@ -40,11 +64,13 @@ void PredictableSource::preload() {
     } else {
         double timeValue;
         while (fin >> timeValue) {
-            timeValue *= scale;
-            arrivalTime += timeValue;
+            double lastArrivalTime = arrivalTime;
+            arrivalTime += timeValue * scale;
             if (arrivalTime >= skip) {
+                if (arrivalTimes.empty()) {
+                    previousArrivalTime = lastArrivalTime - skip;
+                }
                 arrivalTimes.push_back(arrivalTime - skip);
-                interArrivalTimes.push_back(timeValue);
             }
         }
         fin.close();
@@ -52,21 +78,178 @@ void PredictableSource::preload() {
     }
 }
 
+void PredictableSource::mapTrace(const char* filePath) {
+    try {
+        trace.open(filePath);
+    } catch (const std::runtime_error& e) {
+        error("PredictableSource %s: %s", this->getFullName(), e.what());
+    }
+    if (par("verifyTraceChecksum").boolValue() && !trace.verifyChecksum()) {
+        error("PredictableSource %s: checksum of '%s' does not match", this->getFullName(), filePath);
+    }
+
+    // scale and skip are applied when the arrivals are accessed
+    traceScale = trace.getScale() * scale;
+    const double* begin = trace.getArrivalTimes();
+    const double* end = begin + trace.size();
+    const double* first = std::lower_bound(begin, end, skip,
+            [this](double value, double time) { return value * traceScale < time; });
+    traceStart = first - begin;
+    traceCount = end - first;
+    previousArrivalTime = ((traceStart > 0) ? first[-1] * traceScale : 0) - skip;
+    EV << "mapped " << traceCount << " elements from " << filePath << endl;
+}
+
+bool PredictableSource::streamArrivals(double until, bool atLeastOne) {
+    bool appended = false;
+    while ((atLeastOne && !appended) || arrivalTimes.empty() || arrivalTimes.back() < until) {
+        if (streamChunkPosition == streamChunk.size()) {
+            streamChunkPosition = 0;
+            try {
+                if (!streamReader->readChunk(streamChunk)) {
+                    break; // end of trace
+                }
+            } catch (const std::runtime_error& e) {
+                error("PredictableSource %s: %s", this->getFullName(), e.what());
+            }
+        }
+
+        double lastArrivalTime = streamedArrivalTime;
+        streamedArrivalTime += streamChunk[streamChunkPosition++] * scale;
+        if (streamedArrivalTime >= skip) {
+            if (getArrivalCount() == 0) {
+                previousArrivalTime = lastArrivalTime - skip;
+            }
+            arrivalTimes.push_back(streamedArrivalTime - skip);
+            appended = true;
+        }
+    }
+    return appended;
+}
+
+void PredictableSource::discardPastArrivals() {
+
+    // getPrediction() starts at the last scheduled arrival, and uses the one before it
+    while (!arrivalTimes.empty() && discardedArrivals + 2 < nextArrivalIndex) {
+        arrivalTimes.pop_front();
+        discardedArrivals++;
+    }
+
+    /*
+     * the interarrival time of the first arrival kept is unknown, so the
+     * prefix sums up to it are folded into the base (it is only used as the
+     * arrival before a window)
+     */
+    while (!squaredSums.empty() && squaredSumsStart <= discardedArrivals) {
+        squaredSumsBase = squaredSums.front();
+        squaredSums.pop_front();
+        squaredSumsStart++;
+    }
+    if (squaredSums.empty()) {
+        squaredSumsStart = discardedArrivals + 1;
+    }
+}
+
+void PredictableSource::extendSquaredSums(size_t end) {
+    size_t index = squaredSumsStart + squaredSums.size();
+    double sum = (squaredSums.empty()) ? squaredSumsBase : squaredSums.back();
+    for (; index < end; index++) {
+        double interArrival = getInterArrivalTime(index);
+        sum += interArrival * interArrival;
+        squaredSums.push_back(sum);
+    }
+}
+
+size_t PredictableSource::findArrival(size_t low, double time, bool inclusive) const {
+    size_t high = getArrivalCount();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        double arrivalTime = getArrivalTime(middle);
+        if (arrivalTime < time || (inclusive && arrivalTime == time)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+size_t PredictableSource::getFirstPredictableArrival() const {
+    size_t index = nextArrivalIndex;
+    if (index == 0) {
+        index++; // the first one is not really valid because there was no previous arrival
+    } else if (index > 1) {
+        index--; // because nextArrivalIndex points to the next arrival to be scheduled, which means that nextArrivalIndex-1 points to the one that has been scheduled and not happened yet
+    }
+    return index;
+}
+
+size_t PredictableSource::predictWindow(size_t index, double windowStart, double windowEnd,
+        double& average, double& variance, bool debug) {
+    average = 0;
+    variance = 0;
+
+    // arrivals in [windowStart, windowEnd] are [first, last)
+    size_t first = findArrival(index, windowStart, false);
+    size_t last = findArrival(first, windowEnd, true);
+    if (last > first) {
+        extendSquaredSums(last);
+        if (debug) {
+            for (size_t i = first; i < last; i++) {
+                EV << "dbginterarrival value " << getInterArrivalTime(i) << " time " << getArrivalTime(i) << endl;
+            }
+        }
+
+        /*
+         * the interarrival times telescope, so their sum is the difference of
+         * the arrival times. The variance is the second moment about zero,
+         * as it has always been reported.
+         */
+        double count = last - first;
+        average = (getArrivalTime(last - 1) - getArrivalTime(first - 1)) / count;
+        variance = (getSquaredSum(last - 1) - getSquaredSum(first - 1)) / count;
+        if (debug) {
+            EV << "dbginterarrival mean " << average << endl;
+        }
+    }
+    return first;
+}
+
 bool PredictableSource::generateArrival() {
+    if (streamReader) {
+        return streamArrivals(simTime().dbl() + lookahead, true);
+    }
     return false;
 }
 
 void PredictableSource::initialize()
 {
     SourceBase::initialize();
-    scale = par("scale").doubleValue();
+    scale = 1;
+    sessions = par("sessions");
+    requestClassMix.load();
+    demandSampler.initialize(this);
+
+    traceStart = 0;
+    traceCount = 0;
+    traceScale = 1;
+    skip = 0;
+    previousArrivalTime = 0;
+    discardedArrivals = 0;
+    boundedHistory = false;
+    squaredSumsStart = 0;
+    squaredSumsBase = 0;
+    streamChunkPosition = 0;
+    streamedArrivalTime = 0;
+    lookahead = 0;
 
     nextArrivalIndex = 0;
+    readTraceParameters();
     preload();
 
     // schedule the first message timer, if there is one
-    if (interArrivalTimes.size() > 0) {
-        scheduleAt(interArrivalTimes[nextArrivalIndex++], new cMessage("newJobTimer"));
+    if (getArrivalCount() > 0) {
+        scheduleAt(getInterArrivalTime(nextArrivalIndex++), new cMessage("newJobTimer"));
     }
 }
 
@@ -74,12 +257,28 @@ void PredictableSource::handleMessage(cMessage *msg)
 {
     ASSERT(msg->isSelfMessage());
 
-    if (nextArrivalIndex < interArrivalTimes.size() || generateArrival())
+    if (boundedHistory) {
+        discardPastArrivals();
+    }
+    if (streamReader) {
+        streamArrivals(simTime().dbl() + lookahead);
+    }
+
+    if (nextArrivalIndex < getArrivalCount() || generateArrival())
     {
         // reschedule the timer for the next message
-        scheduleAt(simTime() + interArrivalTimes[nextArrivalIndex++], msg);
+        scheduleAt(simTime() + getInterArrivalTime(nextArrivalIndex++), msg);
 
         queueing::Job *job = createJob();
+        if (sessions > 0) {
+            JobAttributes::setSessionId(job, intuniform(0, sessions - 1, SESSION_RNG));
+        }
+        if (!requestClassMix.isEmpty()) {
+            JobAttributes::setRequestClass(job, requestClassMix.select(uniform(0, 1, REQUEST_CLASS_RNG)));
+        }
+        if (demandSampler.isEnabled()) {
+            demandSampler.sample(job);
+        }
         send(job, "out");
     }
     else
@@ -94,41 +293,13 @@ double PredictableSource::getPrediction(double startDelta, double windowDuration
     double average = 0;
     double variance = 0;
 
-    // skip until beginning of window
-    simtime_t start = simTime() + startDelta;
-    unsigned index = nextArrivalIndex;
-    if (index == 0) {
-        index++; // the first one is not really valid because there was no previous arrival
-    } else if (index > 1) {
-        index--; // because nextArrivalIndex points to the next arrival to be scheduled, which means that nextArrivalIndex-1 points to the one that has been scheduled and not happened yet
-    }
-    while (index < arrivalTimes.size() && arrivalTimes[index] < start.dbl()) {
-        index++;
-    }
-
-
-    if (index < arrivalTimes.size()) {
-        accumulator_set<double, stats<tag::mean, tag::moment<2> > > interArrivalStats;
+    double start = (simTime() + startDelta).dbl();
+    if (streamReader) {
 
-        double windowEnd = start.dbl() + windowDuration;
-        while (index < arrivalTimes.size() && arrivalTimes[index] <= windowEnd) {
-            if (debug) {
-                EV << "dbginterarrival value " << interArrivalTimes[index] << " time " << arrivalTimes[index] << endl;
-            }
-            interArrivalStats(interArrivalTimes[index]);
-            index++;
-        }
-
-        average = mean(interArrivalStats);
-        variance = moment<2>(interArrivalStats);
-        if (std::isnan(average)) {
-            average = 0;
-            variance = 0;
-        }
-        if (debug) {
-            EV << "dbginterarrival mean " << average << endl;
-        }
+        // the prediction can only use the arrivals within the lookahead
+        streamArrivals(std::min(start + windowDuration, simTime().dbl() + lookahead));
     }
+    predictWindow(getFirstPredictableArrival(), start, start + windowDuration, average, variance, debug);
 
     if (pVariance) {
         *pVariance = variance;
@@ -136,3 +307,27 @@ double PredictableSource::getPrediction(double startDelta, double windowDuration
     return average;
 }
 
+void PredictableSource::getPredictions(double startDelta, double windowDuration, unsigned windows,
+        std::vector<double>& means, std::vector<double>* pVariances) {
+    means.resize(windows);
+    if (pVariances) {
+        pVariances->resize(windows);
+    }
+
+    double start = (simTime() + startDelta).dbl();
+    if (streamReader) {
+        streamArrivals(std::min(start + windows * windowDuration, simTime().dbl() + lookahead));
+    }
+
+    // each window starts searching where the previous one started
+    size_t index = getFirstPredictableArrival();
+    for (unsigned w = 0; w < windows; w++) {
+        double windowStart = start + w * windowDuration;
+        double variance;
+        index = predictWindow(index, windowStart, windowStart + windowDuration, means[w], variance);
+        if (pVariances) {
+            (*pVariances)[w] = variance;
+        }
+    }
+}
+
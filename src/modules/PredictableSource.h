@@ -17,20 +17,152 @@
 #define __SELFADAPTIVE_PREDICTABLESOURCE_H_
 
 #include "Source.h"
+#include <deque>
+#include <memory>
 #include <vector>
+#include "util/BinaryTrace.h"
+#include "util/TraceStreamReader.h"
+#include "RequestClass.h"
+#include "JobDemandSampler.h"
 
 /**
  * Generates job with predictable interarrival time
+ *
+ * The arrivals are read from a text trace with one interarrival time per
+ * line, or mapped from a binary trace (see BinaryTrace). Subclasses can
+ * generate more arrivals, which are appended after the ones in the trace.
+ *
+ * With streamTrace, the text trace (which can be gzip-compressed) is read
+ * in a background thread, and only the arrivals from the current one up to
+ * the lookahead are kept. Subclasses that generate arrivals can bound the
+ * memory in the same way with boundedHistory.
  */
 class PredictableSource : public queueing::SourceBase
 {
 protected:
-    std::vector<double> arrivalTimes;
-    std::vector<double> interArrivalTimes;
+    /**
+     * Arrival times that are not in the binary trace (i.e., read from a text
+     * trace, or generated)
+     */
+    std::deque<double> arrivalTimes;
+
+    /** arrivals removed from the front of arrivalTimes */
+    size_t discardedArrivals;
+
+    /** whether the arrivals already consumed are discarded */
+    bool boundedHistory;
+
+    BinaryTrace trace;
+    size_t traceStart; /**< index in trace of the first arrival after skip */
+    size_t traceCount; /**< number of arrivals in trace after skip */
+    double traceScale; /**< scale applied to the values in trace */
+    double skip;
+
+    /** arrival time before the first arrival (negative if it was skipped) */
+    double previousArrivalTime;
+
+    /**
+     * Prefix sums of the squared interarrival times, for the arrivals from
+     * squaredSumsStart. They are extended as predictions need them.
+     */
+    std::deque<double> squaredSums;
+    size_t squaredSumsStart;
+    double squaredSumsBase; /**< prefix sum before squaredSumsStart */
+
+    std::unique_ptr<TraceStreamReader> streamReader;
+    std::vector<double> streamChunk; /**< interarrival times being consumed */
+    size_t streamChunkPosition;
+    double streamedArrivalTime; /**< last arrival time read, without skip */
+    double lookahead;
+
     unsigned nextArrivalIndex;
     double scale;
+    unsigned sessions;
+    RequestClassMix requestClassMix;
+    JobDemandSampler demandSampler;
+
+    size_t getArrivalCount() const {
+        return traceCount + discardedArrivals + arrivalTimes.size();
+    }
+
+    /**
+     * Returns the time of an arrival, with scale and skip applied
+     */
+    double getArrivalTime(size_t index) const {
+        if (index < traceCount) {
+            return trace.getArrivalTimes()[traceStart + index] * traceScale - skip;
+        }
+        return arrivalTimes[index - traceCount - discardedArrivals];
+    }
+
+    double getInterArrivalTime(size_t index) const {
+        return getArrivalTime(index) - ((index > 0) ? getArrivalTime(index - 1) : previousArrivalTime);
+    }
+
+    /**
+     * Returns the sum of the squared interarrival times up to index
+     * (inclusive), relative to squaredSumsBase
+     *
+     * extendSquaredSums() must have been called beyond index
+     */
+    double getSquaredSum(size_t index) const {
+        return (index < squaredSumsStart) ? squaredSumsBase : squaredSums[index - squaredSumsStart];
+    }
+
+    void extendSquaredSums(size_t end);
+
+    /**
+     * Binary search for the first arrival from low that is after time (or at
+     * time, if not inclusive)
+     */
+    size_t findArrival(size_t low, double time, bool inclusive) const;
+
+    /**
+     * Returns the first arrival that can be used for predictions
+     */
+    size_t getFirstPredictableArrival() const;
+
+    /**
+     * Computes the mean and variance of the interarrival times of the
+     * arrivals in [windowStart, windowEnd], in O(log n)
+     *
+     * @param index first arrival to consider
+     * @return the first arrival in the window
+     */
+    size_t predictWindow(size_t index, double windowStart, double windowEnd,
+            double& average, double& variance, bool debug = false);
+
+    /**
+     * Maps a binary trace
+     */
+    void mapTrace(const char* filePath);
+
+    /**
+     * Appends streamed arrivals until the last one is at or after the given
+     * time, or the trace ends
+     *
+     * @param atLeastOne append at least one arrival even if the time is
+     *   already covered
+     * @return true if it appended at least one arrival
+     */
+    bool streamArrivals(double until, bool atLeastOne = false);
+
+    /**
+     * Removes the streamed arrivals that are no longer needed, keeping the
+     * ones that getPrediction() may use
+     */
+    void discardPastArrivals();
 
   protected:
+    /**
+     * Reads the parameters of the trace the arrivals come from (e.g.,
+     * scale), before preload()
+     *
+     * Sources that generate their arrivals override it, so that they do not
+     * need the trace parameters
+     */
+    virtual void readTraceParameters();
+
     /**
      * Preload arrival times
      * Must generate at least one arrival
@@ -50,6 +182,18 @@ protected:
   public:
     virtual double getPrediction(double startDelta, double windowDuration, double* pVariance, bool debug = false);
 
+    /**
+     * Computes the predictions for consecutive windows, as getPrediction()
+     * would for each
+     *
+     * @param startDelta start of the first window relative to now
+     * @param windows number of windows (e.g., the horizon)
+     * @param means mean interarrival time of each window
+     * @param pVariances if not null, the variance of each window
+     */
+    virtual void getPredictions(double startDelta, double windowDuration, unsigned windows,
+            std::vector<double>& means, std::vector<double>* pVariances = nullptr);
+
 };
 
 #endif
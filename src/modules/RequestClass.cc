@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "RequestClass.h"
+#include <algorithm>
+#include <util/Utils.h>
+
+using namespace omnetpp;
+
+Define_Module(RequestClass);
+
+const char* RequestClass::MODULE_NAME = "requestClass";
+
+unsigned RequestClass::getCount() {
+    cModule* first = omnetpp::getSimulation()->getSystemModule()->getSubmodule(MODULE_NAME, 0);
+    return (first) ? first->getVectorSize() : 0;
+}
+
+RequestClass* RequestClass::get(unsigned index) {
+    return dynamic_cast<RequestClass*>(omnetpp::getSimulation()->getSystemModule()->getSubmodule(MODULE_NAME, index));
+}
+
+double RequestClass::getMixServiceTime(bool lowFidelity, double* pVariance) {
+    const char* parName = (lowFidelity) ? "lowFidelityServiceTime" : "serviceTime";
+    double totalWeight = 0;
+    double mean = 0;
+    double secondMoment = 0;
+    unsigned count = getCount();
+    for (unsigned c = 0; c < count; c++) {
+        RequestClass* pClass = get(c);
+        double variance = 0;
+        double classMean = Utils::getMeanAndVarianceFromParameter(pClass->par(parName), &variance);
+        double weight = pClass->getWeight();
+        totalWeight += weight;
+        mean += weight * classMean;
+        secondMoment += weight * (variance + classMean * classMean);
+    }
+    if (totalWeight > 0) {
+        mean /= totalWeight;
+        secondMoment /= totalWeight;
+    }
+    if (pVariance) {
+        *pVariance = std::max(0.0, secondMoment - mean * mean);
+    }
+    return mean;
+}
+
+double RequestClass::getWeight() const {
+    return par("weight");
+}
+
+bool RequestClass::isDimmable() const {
+    return par("dimmable");
+}
+
+double RequestClass::getResponseTimeThreshold() const {
+    return par("responseTimeThreshold");
+}
+
+double RequestClass::getBrownoutFactor() const {
+    return (isDimmable()) ? par("brownoutFactor").doubleValue() : 0.0;
+}
+
+void RequestClass::setBrownoutFactor(double factor) {
+    par("brownoutFactor").setDoubleValue(factor);
+}
+
+simtime_t RequestClass::generateServiceTime(bool lowFidelity) {
+    return par((lowFidelity) ? "lowFidelityServiceTime" : "serviceTime");
+}
+
+void RequestClassMix::load() {
+    cumulativeWeights.clear();
+    double total = 0;
+    unsigned count = RequestClass::getCount();
+    for (unsigned c = 0; c < count; c++) {
+        total += RequestClass::get(c)->getWeight();
+        cumulativeWeights.push_back(total);
+    }
+    if (!cumulativeWeights.empty() && total <= 0) {
+        throw cRuntimeError("the weights of the request classes must add up to more than 0");
+    }
+}
+
+bool RequestClassMix::isEmpty() const {
+    return cumulativeWeights.empty();
+}
+
+unsigned RequestClassMix::select(double u) const {
+    auto it = std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), u * cumulativeWeights.back());
+    return std::min<size_t>(it - cumulativeWeights.begin(), cumulativeWeights.size() - 1);
+}
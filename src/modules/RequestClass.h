@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_REQUESTCLASS_H_
+#define __PLASA_REQUESTCLASS_H_
+
+#include <omnetpp.h>
+#include <vector>
+
+/**
+ * Class of requests with its own service times, dimmer, and response time
+ * threshold
+ *
+ * The classes are the elements of the requestClass submodule vector of the
+ * network, and a job belongs to the one given by its request class
+ * attribute (see JobAttributes). Without classes, all requests are served
+ * with the parameters of the servers.
+ */
+class RequestClass : public omnetpp::cSimpleModule
+{
+  public:
+    static const char* MODULE_NAME;
+
+    /**
+     * @return number of request classes in the network
+     */
+    static unsigned getCount();
+
+    /**
+     * @return request class with the given index, or nullptr if there is not one
+     */
+    static RequestClass* get(unsigned index);
+
+    /**
+     * Mean (and variance if pVariance is not null) of the service time of
+     * the mix of requests, weighting each class by its frequency
+     */
+    static double getMixServiceTime(bool lowFidelity, double* pVariance = nullptr);
+
+    double getWeight() const;
+    bool isDimmable() const;
+    double getResponseTimeThreshold() const;
+
+    /**
+     * @return probability that a request is served with low fidelity (0 if
+     *   the class is not dimmable)
+     */
+    double getBrownoutFactor() const;
+    void setBrownoutFactor(double factor);
+
+    omnetpp::simtime_t generateServiceTime(bool lowFidelity);
+};
+
+/**
+ * Selects the class of each job according to the weights of the classes
+ */
+class RequestClassMix
+{
+    std::vector<double> cumulativeWeights;
+
+  public:
+    /**
+     * Reads the weights of the request classes in the network
+     */
+    void load();
+
+    bool isEmpty() const;
+
+    /**
+     * @param u random number uniformly distributed in [0, 1)
+     * @return index of the selected class
+     */
+    unsigned select(double u) const;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "ServerQueue.h"
+#include "Job.h"
+#include "MTServer.h"
+
+using namespace omnetpp;
+
+Define_Module(ServerQueue);
+
+ServerQueue::ServerQueue() : fifo(true), capacity(-1), expectedJobs(0) {}
+
+void ServerQueue::initialize()
+{
+    PassiveQueue::initialize();
+    droppedSignal = registerSignal("dropped");
+    queueingTimeSignal = registerSignal("queueingTime");
+    queueLengthSignal = registerSignal("queueLength");
+
+    capacity = par("capacity");
+    fifo = par("fifo");
+    jobs.setName("queue");
+}
+
+void ServerQueue::handleMessage(cMessage *msg)
+{
+    queueing::Job *job = check_and_cast<queueing::Job *>(msg);
+    job->setTimestamp();
+    if (expectedJobs > 0) {
+        expectedJobs--;
+    }
+
+    // check for container capacity
+    if (capacity >= 0 && jobs.getLength() >= capacity) {
+        EV << "Queue full! Job dropped.\n";
+        if (hasGUI())
+            bubble("Dropped!");
+        emit(droppedSignal, 1L, msg);
+        delete msg;
+        return;
+    }
+
+    int k = selectionStrategy->select();
+    if (k < 0) {
+        // enqueue if no idle server found
+        jobs.insert(job);
+        emit(queueLengthSignal, length());
+        job->setQueueCount(job->getQueueCount() + 1);
+    } else {
+        // send through without queueing
+        sendToServer(job, k);
+    }
+}
+
+void ServerQueue::refreshDisplay() const
+{
+    // change the icon color
+    getDisplayString().setTagArg("i", 1, jobs.isEmpty() ? "" : "cyan");
+}
+
+int ServerQueue::length()
+{
+    return jobs.getLength();
+}
+
+queueing::Job* ServerQueue::dequeue(bool oldest) {
+    queueing::Job *job;
+    if (fifo || oldest) {
+        job = (queueing::Job *) jobs.pop();
+    } else {
+        job = (queueing::Job *) jobs.remove(jobs.back());
+    }
+    emit(queueLengthSignal, length());
+
+    job->setQueueCount(job->getQueueCount() + 1);
+    simtime_t d = simTime() - job->getTimestamp();
+    job->setTotalQueueingTime(job->getTotalQueueingTime() + d);
+    emit(queueingTimeSignal, d);
+    return job;
+}
+
+void ServerQueue::request(int gateIndex)
+{
+    Enter_Method("request()!");
+
+    ASSERT(!jobs.isEmpty());
+    sendToServer(dequeue(false), gateIndex);
+}
+
+void ServerQueue::sendToServer(queueing::Job* job, int gateIndex) {
+    check_and_cast<MTServer*>(gate("out", gateIndex)->getPathEndGate()->getOwnerModule())->reserveThread();
+    send(job, "out", gateIndex);
+}
+
+queueing::Job* ServerQueue::steal() {
+    Enter_Method_Silent("steal()");
+
+    if (jobs.isEmpty()) {
+        return nullptr;
+    }
+    return dequeue(true);
+}
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_SERVERQUEUE_H_
+#define __PLASA_SERVERQUEUE_H_
+
+#include <omnetpp.h>
+#include "PassiveQueue.h"
+
+namespace queueing {
+    class Job;
+}
+
+/**
+ * Queue of an AppServer
+ *
+ * It behaves as queueing::PassiveQueue, but it keeps the jobs itself, so
+ * that other modules can take them out (e.g., work stealing in the
+ * LoadBalancer) with the same bookkeeping as when the server pulls them.
+ */
+class ServerQueue : public queueing::PassiveQueue {
+protected:
+    omnetpp::simsignal_t droppedSignal;
+    omnetpp::simsignal_t queueLengthSignal;
+    omnetpp::simsignal_t queueingTimeSignal;
+
+    bool fifo;
+    int capacity;
+    omnetpp::cQueue jobs;
+
+    /** jobs announced with expectJob() that have not arrived yet */
+    unsigned expectedJobs;
+
+    virtual void initialize() override;
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+    virtual void refreshDisplay() const override;
+
+    /**
+     * Takes a job out of the queue, adding the time it waited to its
+     * queueing time
+     *
+     * @param oldest take the oldest job even if the queue is not fifo
+     */
+    queueing::Job* dequeue(bool oldest);
+
+    /**
+     * Sends a job to the server, taking one of its threads until it arrives
+     */
+    void sendToServer(queueing::Job* job, int gateIndex);
+
+public:
+    ServerQueue();
+
+    virtual int length() override;
+    virtual void request(int gateIndex) override;
+
+    /**
+     * Takes the oldest job out of the queue, so that it can be sent to
+     * another server. The caller must take() the job
+     *
+     * @return nullptr if the queue is empty
+     */
+    queueing::Job* steal();
+
+    /**
+     * Announces a job that is being sent to this queue by a module that
+     * checked that the server was available (e.g., CentralQueue)
+     */
+    void expectJob() {
+        expectedJobs++;
+    }
+
+    unsigned getExpectedJobCount() const {
+        return expectedJobs;
+    }
+};
+
+#endif
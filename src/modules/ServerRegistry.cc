@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "ServerRegistry.h"
+#include "ServerQueue.h"
+#include "MTServer.h"
+
+using namespace omnetpp;
+
+namespace {
+    const char* INTERNAL_SERVER_MODULE_NAME = "server";
+    const char* INTERNAL_QUEUE_MODULE_NAME = "queue";
+}
+
+void ServerRegistry::add(unsigned index, cModule* appServer) {
+    if (index >= entries.size()) {
+        entries.resize(index + 1);
+    }
+    Entry& entry = entries[index];
+    entry.moduleId = appServer->getId();
+    entry.pServer = check_and_cast<MTServer*>(appServer->getSubmodule(INTERNAL_SERVER_MODULE_NAME));
+    entry.pQueue = check_and_cast<ServerQueue*>(appServer->getSubmodule(INTERNAL_QUEUE_MODULE_NAME));
+    version++;
+}
+
+void ServerRegistry::remove(int moduleId) {
+    int index = find(moduleId);
+    if (index >= 0) {
+
+        // servers are always removed from the end of the load balancer gate vector
+        ASSERT(index == (int) entries.size() - 1);
+        entries.erase(entries.begin() + index);
+        version++;
+    }
+}
+
+int ServerRegistry::find(int moduleId) const {
+
+    // search backwards because servers are removed from the end
+    for (int index = entries.size() - 1; index >= 0; index--) {
+        if (entries[index].moduleId == moduleId) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+unsigned ServerRegistry::getJobCount(unsigned index) const {
+    const Entry& entry = entries[index];
+    return entry.pQueue->length() + entry.pServer->getRunningJobCount();
+}
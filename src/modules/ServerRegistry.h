@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef __PLASA_SERVERREGISTRY_H_
+#define __PLASA_SERVERREGISTRY_H_
+
+#include <omnetpp.h>
+#include <vector>
+
+class MTServer;
+class ServerQueue;
+
+/**
+ * Registry of the servers connected to the load balancer
+ *
+ * Entries are indexed by the index of the load balancer output gate the
+ * server is connected to, so that the state of a server (e.g., its queue
+ * length) can be read in O(1) without walking the gates.
+ * It is maintained by ExecutionManagerMod as servers are added and removed.
+ */
+class ServerRegistry {
+public:
+    ServerRegistry() : version(0) {}
+
+    struct Entry {
+        int moduleId; /**< id of the AppServer module */
+        MTServer* pServer;
+        ServerQueue* pQueue;
+    };
+
+    /**
+     * Registers a server
+     *
+     * @param index index of the load balancer output gate connected to the server
+     * @param appServer the AppServer module
+     */
+    void add(unsigned index, omnetpp::cModule* appServer);
+
+    /**
+     * Unregisters a server. It is a noop if the server is not registered
+     * (e.g., it was removed while booting)
+     */
+    void remove(int moduleId);
+
+    /**
+     * @return index of the server, or -1 if it is not registered
+     */
+    int find(int moduleId) const;
+
+    unsigned size() const {
+        return entries.size();
+    }
+
+    const Entry& operator[](unsigned index) const {
+        return entries[index];
+    }
+
+    /**
+     * @return number of jobs in the server, both queued and running
+     */
+    unsigned getJobCount(unsigned index) const;
+
+    /**
+     * @return a number that changes every time a server is added or removed
+     */
+    unsigned getVersion() const {
+        return version;
+    }
+
+protected:
+    std::vector<Entry> entries;
+    unsigned version;
+};
+
+#endif
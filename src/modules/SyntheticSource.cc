@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "SyntheticSource.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+Define_Module(SyntheticSource);
+
+const int RNG = 7;
+
+/*
+ * the rate is bounded over segments of at most this length, so that the
+ * bound stays close to the rate and thinning rejects few candidates
+ */
+const double MAX_SEGMENT = 60;
+
+void SyntheticSource::preload() {
+    const char* simTimeLimit = getEnvir()->getConfig()->getConfigValue("sim-time-limit");
+    maxTime = (simTimeLimit) ? atof(simTimeLimit) : 0;
+    lastArrivalTime = 0;
+    boundedHistory = true;
+
+    rateFunction.add(new SinusoidalRate(par("baseRate").doubleValue(),
+            par("diurnalAmplitude").doubleValue(), par("diurnalPeriod").doubleValue(),
+            par("diurnalPhase").doubleValue()));
+    if (par("rampDelta").doubleValue() != 0) {
+        rateFunction.add(new RampRate(par("rampStart").doubleValue(),
+                par("rampEnd").doubleValue(), par("rampDelta").doubleValue()));
+    }
+    addSpikes(par("spikes").stringValue());
+
+    mmppMultipliers = cStringTokenizer(par("mmppMultipliers").stringValue()).asDoubleVector();
+    mmppSojournTimes = cStringTokenizer(par("mmppSojournTimes").stringValue()).asDoubleVector();
+    if (mmppMultipliers.empty()) {
+        mmppMultipliers.push_back(1);
+    } else if (mmppMultipliers.size() < 2 || mmppSojournTimes.size() != mmppMultipliers.size()) {
+        error("SyntheticSource %s needs a sojourn time for each of two or more MMPP states", getFullName());
+    }
+    mmppGenerator.seed(intuniform(0, INT_MAX, RNG));
+    mmppPath.push_back(MmppSegment{0, 0});
+
+    const char* exportPath = par("exportTraceFile").stringValue();
+    if (exportPath[0] != '\0') {
+        try {
+            traceWriter.open(exportPath);
+        } catch (const std::runtime_error& e) {
+            error("SyntheticSource %s: %s", getFullName(), e.what());
+        }
+    }
+
+    generateArrival();
+}
+
+void SyntheticSource::addSpikes(const char* spikes) {
+    cStringTokenizer spikeTokenizer(spikes, ",");
+    while (spikeTokenizer.hasMoreTokens()) {
+        vector<double> values = cStringTokenizer(spikeTokenizer.nextToken()).asDoubleVector();
+        if (values.size() < 3 || values.size() > 4) {
+            error("SyntheticSource %s: spikes must be \"start duration height [decay]\"", getFullName());
+        }
+        rateFunction.add(new SpikeRate(values[0], values[1], values[2], (values.size() > 3) ? values[3] : 0));
+    }
+}
+
+size_t SyntheticSource::findMmppSegment(double t) {
+    if (mmppMultipliers.size() > 1) {
+        while (mmppPath.back().start <= t) {
+            unsigned state = mmppPath.back().state;
+            exponential_distribution<double> sojourn(1 / mmppSojournTimes[state]);
+            double start = mmppPath.back().start + sojourn(mmppGenerator);
+
+            // move to any of the other states
+            uniform_int_distribution<unsigned> otherState(0, mmppMultipliers.size() - 2);
+            unsigned nextState = otherState(mmppGenerator);
+            if (nextState >= state) {
+                nextState++;
+            }
+            mmppPath.push_back(MmppSegment{start, nextState});
+        }
+    }
+
+    size_t segment = 0;
+    while (segment + 1 < mmppPath.size() && mmppPath[segment + 1].start <= t) {
+        segment++;
+    }
+    return segment;
+}
+
+bool SyntheticSource::generateArrival() {
+
+    // the MMPP states before now are no longer needed
+    while (mmppPath.size() > 1 && mmppPath[1].start <= simTime().dbl()) {
+        mmppPath.pop_front();
+    }
+
+    // thinning: candidates at the max rate of the segment, accepted with probability rate / max rate
+    double t = lastArrivalTime;
+    while (maxTime <= 0 || t < maxTime) {
+        size_t segment = findMmppSegment(t);
+        double segmentEnd = min(rateFunction.getNextBreakpoint(t), t + MAX_SEGMENT);
+        if (segment + 1 < mmppPath.size()) {
+            segmentEnd = min(segmentEnd, mmppPath[segment + 1].start);
+        }
+        double multiplier = mmppMultipliers[mmppPath[segment].state];
+        double maxRate = rateFunction.getMaxRate(t, segmentEnd) * multiplier;
+
+        if (maxRate > 0) {
+            double candidate = t + exponential(1 / maxRate, RNG);
+            if (candidate < segmentEnd) {
+                t = candidate;
+                double rate = rateFunction.getRate(t) * multiplier;
+                if (rate < 0) {
+                    error("SyntheticSource %s: the arrival rate is negative at %g", getFullName(), t);
+                }
+                if (uniform(0, maxRate, RNG) < rate) {
+                    lastArrivalTime = t;
+                    arrivalTimes.push_back(t);
+                    if (traceWriter.isOpen()) {
+                        traceWriter.append(t);
+                    }
+                    return true;
+                }
+                continue;
+            }
+        } else if (mmppMultipliers.size() == 1 && std::isinf(rateFunction.getNextBreakpoint(t))) {
+            break; // the rate is 0 from now on
+        }
+        t = segmentEnd;
+    }
+    lastArrivalTime = t;
+    return false;
+}
+
+double SyntheticSource::getExpectedArrivals(double from, double to) {
+    double expectedArrivals = 0;
+    from = max(from, mmppPath.front().start);
+    size_t segment = findMmppSegment(from);
+    findMmppSegment(to); // extend the path to the end of the window
+    while (segment < mmppPath.size() && mmppPath[segment].start < to) {
+        double segmentFrom = max(from, mmppPath[segment].start);
+        double segmentTo = (segment + 1 < mmppPath.size()) ? min(to, mmppPath[segment + 1].start) : to;
+        expectedArrivals += rateFunction.getIntegral(segmentFrom, segmentTo) * mmppMultipliers[mmppPath[segment].state];
+        segment++;
+    }
+    return expectedArrivals;
+}
+
+double SyntheticSource::getPrediction(double startDelta, double windowDuration, double* pVariance, bool debug) {
+    double start = (simTime() + startDelta).dbl();
+    double expectedArrivals = getExpectedArrivals(start, start + windowDuration);
+    double average = (expectedArrivals > 0) ? windowDuration / expectedArrivals : 0;
+    if (debug) {
+        EV << "dbginterarrival expected arrivals " << expectedArrivals << " mean " << average << endl;
+    }
+
+    /*
+     * the interarrival times are exponential, so the second moment about
+     * zero, which is what is reported for traces, is twice the squared mean
+     */
+    if (pVariance) {
+        *pVariance = 2 * average * average;
+    }
+    return average;
+}
+
+void SyntheticSource::getPredictions(double startDelta, double windowDuration, unsigned windows,
+        std::vector<double>& means, std::vector<double>* pVariances) {
+    means.resize(windows);
+    if (pVariances) {
+        pVariances->resize(windows);
+    }
+    for (unsigned w = 0; w < windows; w++) {
+        double variance;
+        means[w] = getPrediction(startDelta + w * windowDuration, windowDuration, &variance);
+        if (pVariances) {
+            (*pVariances)[w] = variance;
+        }
+    }
+}
+
+void SyntheticSource::finish() {
+    traceWriter.close();
+}
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef SYNTHETICSOURCE_H_
+#define SYNTHETICSOURCE_H_
+
+#include "PredictableSource.h"
+#include <deque>
+#include <random>
+#include <vector>
+#include "util/RateFunctions.h"
+
+/**
+ * Generates arrivals from a synthetic workload
+ *
+ * The arrivals are a nonhomogeneous Poisson process whose rate is the sum
+ * of a sinusoidal (diurnal) rate, a ramp, and step and flash crowd spikes,
+ * multiplied by the state of a Markov-modulated process (MMPP). Arrivals
+ * are generated as needed by thinning, and predictions are computed from
+ * the rate function instead of the arrivals.
+ */
+class SyntheticSource : public PredictableSource {
+protected:
+    SumRate rateFunction;
+
+    /** rate multiplier and mean sojourn time of each MMPP state */
+    std::vector<double> mmppMultipliers;
+    std::vector<double> mmppSojournTimes;
+
+    struct MmppSegment {
+        double start;
+        unsigned state;
+    };
+
+    /**
+     * States of the MMPP from the current time, generated as needed. The
+     * last segment starts after any time asked for so far.
+     */
+    std::deque<MmppSegment> mmppPath;
+
+    /**
+     * The MMPP path has its own generator (seeded from the RNG of the
+     * module), so that predictions, which extend the path, do not change
+     * the arrivals
+     */
+    std::mt19937_64 mmppGenerator;
+
+    double lastArrivalTime; /**< time of the last arrival generated */
+    double maxTime; /**< sim-time-limit */
+    BinaryTraceWriter traceWriter;
+
+    /**
+     * Parses "start duration height [decay], ..."
+     */
+    void addSpikes(const char* spikes);
+
+    /**
+     * Returns the index in mmppPath of the segment that contains t
+     */
+    size_t findMmppSegment(double t);
+
+    /**
+     * Returns the expected number of arrivals in [from, to]
+     */
+    double getExpectedArrivals(double from, double to);
+
+    virtual void readTraceParameters() {} // the arrivals are generated
+    virtual void preload();
+    virtual bool generateArrival();
+    virtual void finish();
+
+public:
+    virtual double getPrediction(double startDelta, double windowDuration, double* pVariance, bool debug = false);
+    virtual void getPredictions(double startDelta, double windowDuration, unsigned windows,
+            std::vector<double>& means, std::vector<double>* pVariances = nullptr);
+};
+
+#endif /* SYNTHETICSOURCE_H_ */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "ArrivalRateEstimators.h"
+
+double ArrivalRateEstimator::getRate() const {
+    return rate;
+}
+
+double ArrivalRateEstimator::getVariance() const {
+    return variance;
+}
+
+
+EwmaArrivalRateEstimator::EwmaArrivalRateEstimator(double alpha) : alpha(alpha) {}
+
+void EwmaArrivalRateEstimator::update(double measuredRate, double measurementVariance, double dt) {
+    if (!initialized) {
+        rate = measuredRate;
+        variance = measurementVariance;
+        initialized = true;
+        return;
+    }
+
+    double residual = measuredRate - rate;
+    rate += alpha * residual;
+    variance = (1 - alpha) * (variance + alpha * residual * residual);
+}
+
+
+HoltArrivalRateEstimator::HoltArrivalRateEstimator(double alpha, double beta)
+    : alpha(alpha), beta(beta) {}
+
+void HoltArrivalRateEstimator::update(double measuredRate, double measurementVariance, double dt) {
+    if (!initialized) {
+        rate = measuredRate;
+        variance = measurementVariance;
+        initialized = true;
+        return;
+    }
+
+    double previousLevel = rate;
+    double forecast = rate + trend * dt;
+    double residual = measuredRate - forecast;
+    rate = forecast + alpha * residual;
+    if (dt > 0) {
+        trend = beta * (rate - previousLevel) / dt + (1 - beta) * trend;
+    }
+    variance = (1 - alpha) * (variance + alpha * residual * residual);
+}
+
+
+KalmanArrivalRateEstimator::KalmanArrivalRateEstimator(double processNoise)
+    : processNoise(processNoise) {}
+
+void KalmanArrivalRateEstimator::update(double measuredRate, double measurementVariance, double dt) {
+    if (!initialized) {
+        rate = measuredRate;
+        variance = measurementVariance;
+        initialized = true;
+        return;
+    }
+
+    // predict
+    variance += processNoise * dt;
+
+    // correct
+    double gain = variance / (variance + measurementVariance);
+    rate += gain * (measuredRate - rate);
+    variance *= (1 - gain);
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef ARRIVALRATEESTIMATORS_H_
+#define ARRIVALRATEESTIMATORS_H_
+
+/**
+ * Online estimator of the arrival rate from periodic measurements
+ *
+ * Each update takes O(1) time and the state is a few doubles.
+ */
+class ArrivalRateEstimator {
+public:
+    virtual ~ArrivalRateEstimator() {}
+
+    /**
+     * @param measuredRate arrival rate measured (requests per second)
+     * @param measurementVariance variance of the measured rate
+     * @param dt time since the previous update in seconds
+     */
+    virtual void update(double measuredRate, double measurementVariance, double dt) = 0;
+
+    /**
+     * Returns the estimated arrival rate
+     */
+    double getRate() const;
+
+    /**
+     * Returns the variance of the estimated arrival rate (its uncertainty)
+     */
+    double getVariance() const;
+
+protected:
+    bool initialized = false;
+    double rate = 0;
+    double variance = 0;
+};
+
+
+/**
+ * Exponentially weighted moving average
+ *
+ * The variance is the exponentially weighted variance of the residuals.
+ */
+class EwmaArrivalRateEstimator : public ArrivalRateEstimator {
+    double alpha;
+
+public:
+    /**
+     * @param alpha smoothing factor in (0, 1]. Higher values react faster
+     */
+    EwmaArrivalRateEstimator(double alpha);
+    virtual void update(double measuredRate, double measurementVariance, double dt);
+};
+
+
+/**
+ * Holt's linear (double exponential) smoothing
+ *
+ * It tracks the level and the trend of the rate, so it follows ramps
+ * without the lag of the EWMA. The estimate is the level.
+ */
+class HoltArrivalRateEstimator : public ArrivalRateEstimator {
+    double alpha;
+    double beta;
+    double trend = 0; /**< change of the rate per second */
+
+public:
+    /**
+     * @param alpha smoothing factor for the level in (0, 1]
+     * @param beta smoothing factor for the trend in (0, 1]
+     */
+    HoltArrivalRateEstimator(double alpha, double beta);
+    virtual void update(double measuredRate, double measurementVariance, double dt);
+};
+
+
+/**
+ * Scalar Kalman filter for a rate that follows a random walk
+ */
+class KalmanArrivalRateEstimator : public ArrivalRateEstimator {
+    double processNoise;
+
+public:
+    /**
+     * @param processNoise variance of the change of the rate per second
+     */
+    KalmanArrivalRateEstimator(double processNoise);
+    virtual void update(double measuredRate, double measurementVariance, double dt);
+};
+
+#endif /* ARRIVALRATEESTIMATORS_H_ */
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "BinaryTrace.h"
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+const char BinaryTrace::MAGIC[8] = {'S', 'W', 'I', 'M', 'T', 'R', 'C', '\0'};
+const uint64_t BinaryTrace::CHECKSUM_SEED = 14695981039346656037ULL; // FNV offset basis
+
+BinaryTrace::BinaryTrace()
+    : mapping(nullptr), mappingSize(0), header(nullptr), arrivalTimes(nullptr) {
+}
+
+BinaryTrace::~BinaryTrace() {
+    close();
+}
+
+void BinaryTrace::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("BinaryTrace::open could not open '" + path + "'");
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof(Header)) {
+        ::close(fd);
+        throw runtime_error("BinaryTrace::open '" + path + "' is not a binary trace");
+    }
+
+    mappingSize = fileStat.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file open
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw runtime_error("BinaryTrace::open could not map '" + path + "'");
+    }
+
+    header = static_cast<const Header*>(mapping);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        close();
+        throw runtime_error("BinaryTrace::open '" + path + "' is not a binary trace");
+    }
+    if (header->version != VERSION) {
+        close();
+        throw runtime_error("BinaryTrace::open '" + path + "' has an unsupported version");
+    }
+    if (header->headerSize < sizeof(Header)
+            || header->headerSize + header->count * sizeof(double) > mappingSize) {
+        close();
+        throw runtime_error("BinaryTrace::open '" + path + "' is truncated");
+    }
+    arrivalTimes = reinterpret_cast<const double*>(
+            static_cast<const char*>(mapping) + header->headerSize);
+}
+
+void BinaryTrace::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    arrivalTimes = nullptr;
+}
+
+bool BinaryTrace::isOpen() const {
+    return mapping != nullptr;
+}
+
+size_t BinaryTrace::size() const {
+    return (header) ? header->count : 0;
+}
+
+double BinaryTrace::getScale() const {
+    return (header) ? header->scale : 1.0;
+}
+
+const double* BinaryTrace::getArrivalTimes() const {
+    return arrivalTimes;
+}
+
+bool BinaryTrace::verifyChecksum() const {
+    return header && computeChecksum(arrivalTimes, header->count) == header->checksum;
+}
+
+bool BinaryTrace::isBinaryTrace(const std::string& path) {
+    ifstream fin(path, ios::binary);
+    char magic[sizeof(MAGIC)];
+    return fin.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+BinaryTrace::Header BinaryTrace::makeHeader(double scale, uint64_t count, uint64_t checksum) {
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.scale = scale;
+    header.count = count;
+    header.checksum = checksum;
+    return header;
+}
+
+void BinaryTrace::write(std::ostream& out, const std::vector<double>& arrivalTimes, double scale) {
+    Header header = makeHeader(scale, arrivalTimes.size(),
+            computeChecksum(arrivalTimes.data(), arrivalTimes.size()));
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(arrivalTimes.data()), arrivalTimes.size() * sizeof(double));
+}
+
+/*
+ * 64-bit FNV-1a over the bytes of the values
+ */
+uint64_t BinaryTrace::computeChecksum(const double* values, size_t count) {
+    return updateChecksum(CHECKSUM_SEED, values, count);
+}
+
+uint64_t BinaryTrace::updateChecksum(uint64_t checksum, const double* values, size_t count) {
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hash = checksum;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+    for (size_t i = 0; i < count * sizeof(double); i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+
+BinaryTraceWriter::BinaryTraceWriter() : scale(1), count(0), checksum(BinaryTrace::CHECKSUM_SEED) {
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+    close();
+}
+
+void BinaryTraceWriter::open(const std::string& path, double scale) {
+    close();
+    out.open(path, ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("BinaryTraceWriter::open could not create '" + path + "'");
+    }
+    this->scale = scale;
+    count = 0;
+    checksum = BinaryTrace::CHECKSUM_SEED;
+
+    // placeholder until the count and checksum are known
+    BinaryTrace::Header header = BinaryTrace::makeHeader(scale, 0, checksum);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void BinaryTraceWriter::append(double arrivalTime) {
+    out.write(reinterpret_cast<const char*>(&arrivalTime), sizeof(arrivalTime));
+    checksum = BinaryTrace::updateChecksum(checksum, &arrivalTime, 1);
+    count++;
+}
+
+void BinaryTraceWriter::close() {
+    if (out.is_open()) {
+        BinaryTrace::Header header = BinaryTrace::makeHeader(scale, count, checksum);
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+    }
+}
+
+bool BinaryTraceWriter::isOpen() const {
+    return out.is_open();
+}
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef BINARYTRACE_H_
+#define BINARYTRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Read-only access to a binary arrival trace mapped in memory
+ *
+ * The file starts with a BinaryTrace::Header followed by count doubles
+ * with the cumulative arrival times (i.e., the running sum of the
+ * interarrival times of a .delta trace), in the byte order of the machine
+ * that wrote it. Storing arrival times rather than interarrival times
+ * allows binary searches, and the interarrival times are the differences
+ * between consecutive values. The values are stored unscaled, and the
+ * readers multiply them by the scale in the header.
+ *
+ * Opening a trace does not read the values, so the pages are only loaded
+ * as they are accessed, and they are shared by all the processes using the
+ * same trace.
+ */
+class BinaryTrace {
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize; /**< offset of the arrival times in the file */
+        double scale; /**< factor to convert the stored values to seconds */
+        uint64_t count; /**< number of arrival times */
+        uint64_t checksum; /**< checksum of the arrival times */
+    };
+
+    BinaryTrace();
+    virtual ~BinaryTrace();
+
+    /**
+     * Maps the trace in memory
+     *
+     * @throws std::runtime_error if the file cannot be mapped, or it is not a
+     *   binary trace of this version
+     */
+    void open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    size_t size() const;
+    double getScale() const;
+
+    /**
+     * Returns the unscaled arrival times
+     */
+    const double* getArrivalTimes() const;
+
+    /**
+     * Reads all the values to check the checksum in the header
+     */
+    bool verifyChecksum() const;
+
+    /**
+     * @return true if the file starts with the magic of a binary trace
+     */
+    static bool isBinaryTrace(const std::string& path);
+
+    /**
+     * Writes a binary trace
+     *
+     * @param arrivalTimes unscaled arrival times, in non-decreasing order
+     */
+    static void write(std::ostream& out, const std::vector<double>& arrivalTimes, double scale);
+
+    static uint64_t computeChecksum(const double* values, size_t count);
+
+    /**
+     * Adds values to a checksum, so that it can be computed incrementally
+     * starting from CHECKSUM_SEED
+     */
+    static uint64_t updateChecksum(uint64_t checksum, const double* values, size_t count);
+    static const uint64_t CHECKSUM_SEED;
+
+    static Header makeHeader(double scale, uint64_t count, uint64_t checksum);
+
+protected:
+    void* mapping;
+    size_t mappingSize;
+    const Header* header;
+    const double* arrivalTimes;
+
+private:
+    BinaryTrace(const BinaryTrace&) = delete;
+    BinaryTrace& operator=(const BinaryTrace&) = delete;
+};
+
+
+/**
+ * Writes a binary trace one arrival at a time
+ *
+ * The header is written when the trace is closed, once the count and
+ * checksum are known.
+ */
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter();
+    virtual ~BinaryTraceWriter();
+
+    /**
+     * @throws std::runtime_error if the file cannot be created
+     */
+    void open(const std::string& path, double scale = 1);
+
+    /**
+     * @param arrivalTime unscaled, not earlier than the previous one
+     */
+    void append(double arrivalTime);
+
+    /**
+     * Writes the header and closes the file
+     */
+    void close();
+    bool isOpen() const;
+
+protected:
+    std::ofstream out;
+    double scale;
+    uint64_t count;
+    uint64_t checksum;
+};
+
+#endif /* BINARYTRACE_H_ */
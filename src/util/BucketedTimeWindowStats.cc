@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "BucketedTimeWindowStats.h"
+
+using namespace std;
+
+template <class Clock>
+BasicBucketedTimeWindowStats<Clock>::BasicBucketedTimeWindowStats(unsigned buckets)
+    : buckets(max(buckets, 1u)), start(Clock::now()) {
+    setWindow(60);
+}
+
+template <class Clock>
+void BasicBucketedTimeWindowStats<Clock>::reset() {
+    start = Clock::now();
+    lastChange = Timestamp();
+    for (auto& bucket : buckets) {
+        bucket = Bucket();
+    }
+}
+
+template <class Clock>
+void BasicBucketedTimeWindowStats<Clock>::setWindow(unsigned seconds) {
+    bucketWidth = Clock::divide(Clock::fromSeconds(seconds), buckets.size());
+    reset();
+}
+
+template <class Clock>
+void BasicBucketedTimeWindowStats<Clock>::record(double value) {
+    auto now = Clock::now();
+    if (lastValue > 0) {
+        addAboveZero(lastChange, now);
+    }
+
+    Bucket& bucket = getBucket(getBucketIndex(now));
+    bucket.count++;
+    double delta = value - bucket.mean;
+    bucket.mean += delta / bucket.count;
+    bucket.m2 += delta * (value - bucket.mean);
+
+    lastChange = now;
+    lastValue = value;
+}
+
+template <class Clock>
+long BasicBucketedTimeWindowStats<Clock>::getBucketIndex(Timestamp t) const {
+    return Clock::getSlot(t, bucketWidth);
+}
+
+template <class Clock>
+typename BasicBucketedTimeWindowStats<Clock>::Bucket BasicBucketedTimeWindowStats<Clock>::getWindowSummary() const {
+    long current = getBucketIndex(Clock::now());
+    Bucket summary;
+    for (const auto& bucket : buckets) {
+        if (isInWindow(bucket, current) && bucket.count > 0) {
+
+            /* Chan et al.'s pairwise update */
+            unsigned count = summary.count + bucket.count;
+            double delta = bucket.mean - summary.mean;
+            summary.mean += delta * bucket.count / count;
+            summary.m2 += bucket.m2 + delta * delta * summary.count * bucket.count / count;
+            summary.count = count;
+        }
+    }
+
+    return summary;
+}
+
+template <class Clock>
+typename BasicBucketedTimeWindowStats<Clock>::Bucket& BasicBucketedTimeWindowStats<Clock>::getBucket(long index) {
+    Bucket& bucket = buckets[index % buckets.size()];
+    if (bucket.index != index) {
+        bucket = Bucket();
+        bucket.index = index;
+    }
+    return bucket;
+}
+
+template <class Clock>
+bool BasicBucketedTimeWindowStats<Clock>::isInWindow(const Bucket& bucket, long current) const {
+    return bucket.index > current - (long) buckets.size() && bucket.index <= current;
+}
+
+template <class Clock>
+typename BasicBucketedTimeWindowStats<Clock>::Duration BasicBucketedTimeWindowStats<Clock>::getCoveredDuration(long current) const {
+    auto windowStart = Clock::fromEpoch(Clock::multiply(bucketWidth, current - (long) buckets.size() + 1));
+    return Clock::now() - windowStart;
+}
+
+template <class Clock>
+void BasicBucketedTimeWindowStats<Clock>::addAboveZero(Timestamp from, Timestamp to) {
+    long first = getBucketIndex(from);
+    long last = getBucketIndex(to);
+
+    // only the last buckets.size() time slots can still be in a window
+    first = max(first, last - (long) buckets.size() + 1);
+    for (long index = first; index <= last; index++) {
+        auto slotStart = Clock::fromEpoch(Clock::multiply(bucketWidth, index));
+        auto start = max(from, slotStart);
+        auto end = min(to, slotStart + bucketWidth);
+        if (start < end) {
+            getBucket(index).aboveZero += end - start;
+        }
+    }
+}
+
+template <class Clock>
+double BasicBucketedTimeWindowStats<Clock>::getAverage() {
+    return getWindowSummary().mean;
+}
+
+template <class Clock>
+double BasicBucketedTimeWindowStats<Clock>::getVariance() {
+    Bucket summary = getWindowSummary();
+    return (summary.count > 0) ? max(summary.m2 / summary.count, 0.0) : 0.0;
+}
+
+template <class Clock>
+double BasicBucketedTimeWindowStats<Clock>::getRate() {
+    auto now = Clock::now();
+    Duration covered = getCoveredDuration(getBucketIndex(now));
+    double elapsed = Clock::toSeconds(min(covered, now - start));
+    return (elapsed > 0) ? double(getCount()) / elapsed : 0.0;
+}
+
+template <class Clock>
+unsigned BasicBucketedTimeWindowStats<Clock>::getCount() {
+    return getWindowSummary().count;
+}
+
+template <class Clock>
+double BasicBucketedTimeWindowStats<Clock>::getPercentageAboveZero() {
+    auto now = Clock::now();
+    long current = getBucketIndex(now);
+    Duration covered = getCoveredDuration(current);
+    if (covered == Duration(0)) {
+        return (lastValue > 0) ? 1.0 : 0.0;
+    }
+
+    Duration aboveZero(0);
+    for (const auto& bucket : buckets) {
+        if (isInWindow(bucket, current)) {
+            aboveZero += bucket.aboveZero;
+        }
+    }
+
+    if (lastValue > 0) {
+
+        /* the level is still above 0, but that hasn't been added to the buckets yet */
+        auto windowStart = now - covered;
+        aboveZero += now - max(lastChange, windowStart);
+    }
+
+    return Clock::toSeconds(aboveZero) / Clock::toSeconds(covered);
+}
+
+template class BasicBucketedTimeWindowStats<SimClock>;
+template class BasicBucketedTimeWindowStats<SteadyClock>;
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef BUCKETEDTIMEWINDOWSTATS_H_
+#define BUCKETEDTIMEWINDOWSTATS_H_
+
+#include "Clocks.h"
+#include "WindowStats.h"
+#include <vector>
+
+/**
+ * Computes statistics for events in a sliding time window using a ring of
+ * sub-window buckets instead of keeping every entry
+ *
+ * Each bucket aggregates the entries recorded during its time slot, so the
+ * memory used is constant regardless of the event rate. The window slides
+ * one bucket at a time: the statistics cover the current (partial) bucket
+ * and the previous ones, that is, between window - window/buckets and
+ * window seconds. More buckets give finer resolution at the cost of more
+ * work per query.
+ *
+ * Each bucket keeps the mean and the sum of squared deviations of its
+ * entries (Welford's update), and the buckets in the window are merged
+ * with Chan's formula, so the variance does not suffer the cancellation of
+ * subtracting the squared mean from the mean of the squares.
+ *
+ * @tparam Clock clock policy (see Clocks.h)
+ *
+ * @note This class is not thread-safe (intended for use in OMNET++)
+ */
+template <class Clock>
+class BasicBucketedTimeWindowStats : public WindowStats {
+public:
+    /**
+     * @param buckets number of buckets the window is divided into
+     */
+    BasicBucketedTimeWindowStats(unsigned buckets = 60);
+
+    virtual void reset();
+    virtual void setWindow(unsigned seconds);
+    virtual void record(double value);
+    virtual double getAverage();
+    virtual double getVariance();
+    virtual double getRate();
+    virtual unsigned getCount();
+    virtual double getPercentageAboveZero();
+
+protected:
+    using Duration = typename Clock::Duration;
+    using Timestamp = typename Clock::Timestamp;
+
+    struct Bucket {
+        long index = -1; /**< absolute number of the time slot it holds */
+        unsigned count = 0;
+        double mean = 0;
+        double m2 = 0; /**< sum of squared differences from the mean */
+        Duration aboveZero = Duration(); /**< time the level was above 0 */
+    };
+
+    std::vector<Bucket> buckets;
+    Duration bucketWidth;
+
+    /**
+     * When the collection of statistics started (for the rate before a
+     * whole window has elapsed)
+     */
+    Timestamp start;
+
+    double lastValue = 0; /**< keeps the last value even if it falls out of the window */
+
+    /** time of the last recorded entry (the level applies from then on) */
+    Timestamp lastChange = Timestamp();
+
+    /**
+     * Returns the absolute number of the time slot that contains t
+     */
+    long getBucketIndex(Timestamp t) const;
+
+    /**
+     * Returns the count, mean and sum of squared differences from the mean
+     * of the entries in the window, merging the buckets that are in it
+     */
+    Bucket getWindowSummary() const;
+
+    /**
+     * Returns the bucket for a time slot, clearing it if it held an old one
+     */
+    Bucket& getBucket(long index);
+
+    /**
+     * Returns true if the bucket holds a time slot within the window ending
+     * in the time slot current
+     */
+    bool isInWindow(const Bucket& bucket, long current) const;
+
+    /**
+     * Returns the time the window covers (from the start of its first time slot)
+     */
+    Duration getCoveredDuration(long current) const;
+
+    /**
+     * Adds the time between from and to to the aboveZero time of the buckets
+     */
+    void addAboveZero(Timestamp from, Timestamp to);
+};
+
+typedef BasicBucketedTimeWindowStats<SimClock> BucketedTimeWindowStats;
+typedef BasicBucketedTimeWindowStats<SteadyClock> RealBucketedTimeWindowStats;
+
+extern template class BasicBucketedTimeWindowStats<SimClock>;
+extern template class BasicBucketedTimeWindowStats<SteadyClock>;
+
+#endif /* BUCKETEDTIMEWINDOWSTATS_H_ */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef CLOCKS_H_
+#define CLOCKS_H_
+
+#include <chrono>
+#include <cmath>
+#include <omnetpp.h>
+
+/*
+ * Clock policies for the time window statistics
+ *
+ * A policy defines the Duration and Timestamp types and the few operations
+ * on them that the statistics need, so that the same implementation can be
+ * used with the simulation clock and with the real time clock.
+ */
+
+/**
+ * Simulation clock (OMNeT++ simulation time)
+ */
+struct SimClock {
+    using Duration = omnetpp::simtime_t;
+    using Timestamp = omnetpp::simtime_t;
+
+    static Timestamp now() {
+        return omnetpp::simTime();
+    }
+
+    static Duration fromSeconds(unsigned seconds) {
+        return Duration(double(seconds));
+    }
+
+    static double toSeconds(Duration d) {
+        return d.dbl();
+    }
+
+    static Timestamp fromEpoch(Duration d) {
+        return d;
+    }
+
+    static Duration divide(Duration d, unsigned n) {
+        return d / double(n);
+    }
+
+    static Duration multiply(Duration d, long n) {
+        return d * double(n);
+    }
+
+    /**
+     * Returns the number of the time slot of the given width that contains t
+     */
+    static long getSlot(Timestamp t, Duration width) {
+        return (long) floor(t / width);
+    }
+};
+
+/**
+ * Real time monotonic clock (std::chrono::steady_clock)
+ *
+ * All the operations are done on integer ticks.
+ */
+struct SteadyClock {
+    using clock = std::chrono::steady_clock;
+    using Duration = clock::duration;
+    using Timestamp = clock::time_point;
+
+    static Timestamp now() {
+        return clock::now();
+    }
+
+    static Duration fromSeconds(unsigned seconds) {
+        return std::chrono::duration_cast<Duration>(std::chrono::seconds(seconds));
+    }
+
+    static double toSeconds(Duration d) {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    static Timestamp fromEpoch(Duration d) {
+        return Timestamp(d);
+    }
+
+    static Duration divide(Duration d, unsigned n) {
+        return d / n;
+    }
+
+    static Duration multiply(Duration d, long n) {
+        return d * n;
+    }
+
+    /**
+     * Returns the number of the time slot of the given width that contains t
+     */
+    static long getSlot(Timestamp t, Duration width) {
+        return (long) (t.time_since_epoch() / width);
+    }
+};
+
+#endif /* CLOCKS_H_ */
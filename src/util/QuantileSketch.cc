@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "QuantileSketch.h"
+#include <cmath>
+#include <omnetpp.h>
+
+using namespace std;
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, double minValue,
+        double maxValue) :
+        gamma((1 + relativeAccuracy) / (1 - relativeAccuracy)),
+        logGamma(log(gamma)),
+        minValue(minValue),
+        count(0) {
+    ASSERT(relativeAccuracy > 0 && relativeAccuracy < 1);
+    ASSERT(minValue > 0 && maxValue > minValue);
+    counts.resize(2 + (unsigned) ceil(log(maxValue / minValue) / logGamma), 0);
+}
+
+unsigned QuantileSketch::getIndex(double value) const {
+    if (value <= minValue) {
+        return 0;
+    }
+    double index = ceil(log(value / minValue) / logGamma);
+    return (unsigned) min(index, double(counts.size() - 1));
+}
+
+double QuantileSketch::getValue(unsigned index) const {
+    if (index == 0) {
+        return minValue;
+    }
+    double lowerBound = minValue * pow(gamma, index - 1);
+    return lowerBound * 2 * gamma / (gamma + 1);
+}
+
+void QuantileSketch::record(double value) {
+    counts[getIndex(value)]++;
+    count++;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    ASSERT(counts.size() == other.counts.size());
+    for (unsigned i = 0; i < counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+}
+
+void QuantileSketch::subtract(const QuantileSketch& other) {
+    ASSERT(counts.size() == other.counts.size());
+    for (unsigned i = 0; i < counts.size(); i++) {
+        ASSERT(counts[i] >= other.counts[i]);
+        counts[i] -= other.counts[i];
+    }
+    count -= other.count;
+}
+
+void QuantileSketch::clear() {
+    fill(counts.begin(), counts.end(), 0);
+    count = 0;
+}
+
+unsigned long QuantileSketch::getCount() const {
+    return count;
+}
+
+double QuantileSketch::getQuantile(double quantile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    double rank = quantile * (count - 1);
+    unsigned long cumulative = 0;
+    unsigned index = 0;
+    while (index < counts.size() - 1) {
+        cumulative += counts[index];
+        if (cumulative > rank) {
+            break;
+        }
+        index++;
+    }
+
+    return getValue(index);
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef QUANTILESKETCH_H_
+#define QUANTILESKETCH_H_
+
+#include <vector>
+
+/**
+ * Fixed-memory quantile sketch with relative accuracy guarantees
+ *
+ * Values are counted in buckets with logarithmically growing boundaries, so
+ * any quantile is estimated within the given relative error. Values below
+ * minValue or above maxValue are clamped to those limits. Sketches with the
+ * same configuration can be merged and subtracted, which makes it possible
+ * to combine sub-windows.
+ */
+class QuantileSketch {
+public:
+    /**
+     * @param relativeAccuracy max relative error of the quantiles (e.g., 0.01)
+     * @param minValue values smaller than this are counted as minValue
+     * @param maxValue values larger than this are counted as maxValue
+     */
+    QuantileSketch(double relativeAccuracy = 0.01, double minValue = 1e-6,
+            double maxValue = 1e6);
+
+    void record(double value);
+
+    /**
+     * Adds the counts of another sketch with the same configuration
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * Removes the counts of a sketch that was merged into this one
+     */
+    void subtract(const QuantileSketch& other);
+
+    void clear();
+    unsigned long getCount() const;
+
+    /**
+     * @param quantile in [0, 1]
+     * @return estimated value of the quantile, or 0 if no values were recorded
+     */
+    double getQuantile(double quantile) const;
+
+protected:
+    double gamma; /**< ratio between the upper and lower bounds of a bucket */
+    double logGamma;
+    double minValue;
+
+    /** counts[0] is for values <= minValue, and counts[i] for (minValue * gamma^(i-1), minValue * gamma^i] */
+    std::vector<unsigned long> counts;
+    unsigned long count;
+
+    unsigned getIndex(double value) const;
+
+    /**
+     * Returns the value that represents the bucket with the least relative error
+     */
+    double getValue(unsigned index) const;
+};
+
+#endif /* QUANTILESKETCH_H_ */
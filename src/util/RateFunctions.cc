@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "RateFunctions.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+const double INFINITE_TIME = numeric_limits<double>::infinity();
+
+double RateFunction::getNextBreakpoint(double t) const {
+    return INFINITE_TIME;
+}
+
+
+SinusoidalRate::SinusoidalRate(double mean, double amplitude, double period, double phase)
+    : mean(mean), amplitude(amplitude), period(period), phase(phase) {
+    if (period <= 0) {
+        this->amplitude = 0;
+    }
+}
+
+double SinusoidalRate::getRate(double t) const {
+    if (amplitude == 0) {
+        return mean;
+    }
+    return mean + amplitude * sin(2 * M_PI * (t - phase) / period);
+}
+
+double SinusoidalRate::getIntegral(double from, double to) const {
+    double integral = mean * (to - from);
+    if (amplitude != 0) {
+        double omega = 2 * M_PI / period;
+        integral -= amplitude / omega * (cos(omega * (to - phase)) - cos(omega * (from - phase)));
+    }
+    return integral;
+}
+
+double SinusoidalRate::getMaxRate(double from, double to) const {
+    double maxRate = max(getRate(from), getRate(to));
+    if (amplitude != 0) {
+
+        // is there a peak of the rate in the interval?
+        double omega = 2 * M_PI / period;
+        double peakAngle = (amplitude > 0) ? M_PI / 2 : 3 * M_PI / 2;
+        double angle = omega * (from - phase);
+        double nextPeakAngle = peakAngle + 2 * M_PI * ceil((angle - peakAngle) / (2 * M_PI));
+        if (nextPeakAngle <= omega * (to - phase)) {
+            maxRate = mean + fabs(amplitude);
+        }
+    }
+    return maxRate;
+}
+
+
+RampRate::RampRate(double start, double end, double delta)
+    : start(start), end(max(start, end)), delta(delta) {
+}
+
+double RampRate::getRate(double t) const {
+    if (t < start) {
+        return 0;
+    } else if (t >= end) {
+        return delta;
+    }
+    return delta * (t - start) / (end - start);
+}
+
+double RampRate::getIntegral(double from, double to) const {
+    double integral = 0;
+
+    // linear part (trapezoid)
+    double rampFrom = max(from, start);
+    double rampTo = min(to, end);
+    if (rampTo > rampFrom) {
+        integral += (getRate(rampFrom) + getRate(rampTo)) / 2 * (rampTo - rampFrom);
+    }
+
+    // constant part after the ramp
+    if (to > end) {
+        integral += delta * (to - max(from, end));
+    }
+    return integral;
+}
+
+double RampRate::getMaxRate(double from, double to) const {
+    return max(getRate(from), getRate(to)); // monotone
+}
+
+double RampRate::getNextBreakpoint(double t) const {
+    if (t < start) {
+        return start;
+    } else if (t < end) {
+        return end;
+    }
+    return INFINITE_TIME;
+}
+
+
+SpikeRate::SpikeRate(double start, double duration, double height, double decay)
+    : start(start), end(start + max(duration, 0.0)), height(height), decay(max(decay, 0.0)) {
+}
+
+double SpikeRate::getSpikeRate(double t) const {
+    if (decay == 0) {
+        return height;
+    }
+    return height * exp(-(t - start) / decay);
+}
+
+double SpikeRate::getRate(double t) const {
+    if (t < start || t >= end) {
+        return 0;
+    }
+    return getSpikeRate(t);
+}
+
+double SpikeRate::getIntegral(double from, double to) const {
+    double spikeFrom = max(from, start);
+    double spikeTo = min(to, end);
+    if (spikeTo <= spikeFrom) {
+        return 0;
+    }
+    if (decay == 0) {
+        return height * (spikeTo - spikeFrom);
+    }
+    return height * decay * (exp(-(spikeFrom - start) / decay) - exp(-(spikeTo - start) / decay));
+}
+
+double SpikeRate::getMaxRate(double from, double to) const {
+    double spikeFrom = max(from, start);
+    double spikeTo = min(to, end);
+    if (spikeTo < spikeFrom) {
+        return 0;
+    }
+
+    // monotone in the spike, and 0 outside
+    double maxRate = max(getSpikeRate(spikeFrom), getSpikeRate(spikeTo));
+    if (from < start || to >= end) {
+        maxRate = max(maxRate, 0.0);
+    }
+    return maxRate;
+}
+
+double SpikeRate::getNextBreakpoint(double t) const {
+    if (t < start) {
+        return start;
+    } else if (t < end) {
+
+        // a flash crowd is bounded one time constant at a time
+        return (decay > 0) ? min(end, t + decay) : end;
+    }
+    return INFINITE_TIME;
+}
+
+
+void SumRate::add(RateFunction* term) {
+    terms.push_back(std::unique_ptr<RateFunction>(term));
+}
+
+double SumRate::getRate(double t) const {
+    double rate = 0;
+    for (const auto& term : terms) {
+        rate += term->getRate(t);
+    }
+    return rate;
+}
+
+double SumRate::getIntegral(double from, double to) const {
+    double integral = 0;
+    for (const auto& term : terms) {
+        integral += term->getIntegral(from, to);
+    }
+    return integral;
+}
+
+double SumRate::getMaxRate(double from, double to) const {
+    double maxRate = 0;
+    for (const auto& term : terms) {
+        maxRate += term->getMaxRate(from, to);
+    }
+    return maxRate;
+}
+
+double SumRate::getNextBreakpoint(double t) const {
+    double breakpoint = INFINITE_TIME;
+    for (const auto& term : terms) {
+        breakpoint = min(breakpoint, term->getNextBreakpoint(t));
+    }
+    return breakpoint;
+}
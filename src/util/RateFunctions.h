@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef RATEFUNCTIONS_H_
+#define RATEFUNCTIONS_H_
+
+#include <memory>
+#include <vector>
+
+/**
+ * Deterministic arrival rate as a function of time, with closed forms for
+ * its integral (the expected number of arrivals) and its maximum in an
+ * interval (the bound for generating arrivals by thinning)
+ */
+class RateFunction {
+public:
+    virtual ~RateFunction() {}
+
+    /**
+     * Returns the rate (requests per second) at time t
+     */
+    virtual double getRate(double t) const = 0;
+
+    /**
+     * Returns the integral of the rate in [from, to]
+     */
+    virtual double getIntegral(double from, double to) const = 0;
+
+    /**
+     * Returns an upper bound of the rate in [from, to]
+     */
+    virtual double getMaxRate(double from, double to) const = 0;
+
+    /**
+     * Returns the first time after t at which the rate changes abruptly, or
+     * after which getMaxRate() would not be tight, or infinity
+     */
+    virtual double getNextBreakpoint(double t) const;
+};
+
+
+/**
+ * mean + amplitude * sin(2 * pi * (t - phase) / period)
+ *
+ * With amplitude 0 it is a constant rate. The amplitude must not be larger
+ * than the mean for the rate to be non-negative.
+ */
+class SinusoidalRate : public RateFunction {
+    double mean;
+    double amplitude;
+    double period;
+    double phase;
+
+public:
+    SinusoidalRate(double mean, double amplitude = 0, double period = 0, double phase = 0);
+    virtual double getRate(double t) const;
+    virtual double getIntegral(double from, double to) const;
+    virtual double getMaxRate(double from, double to) const;
+};
+
+
+/**
+ * Linear change of the rate by delta between start and end, which remains
+ * after end
+ */
+class RampRate : public RateFunction {
+    double start;
+    double end;
+    double delta;
+
+public:
+    RampRate(double start, double end, double delta);
+    virtual double getRate(double t) const;
+    virtual double getIntegral(double from, double to) const;
+    virtual double getMaxRate(double from, double to) const;
+    virtual double getNextBreakpoint(double t) const;
+};
+
+
+/**
+ * Extra rate during [start, start + duration)
+ *
+ * With decay 0 it is a step. Otherwise it is a flash crowd, which starts
+ * with the given height and decays exponentially with the given time
+ * constant.
+ */
+class SpikeRate : public RateFunction {
+    double start;
+    double end;
+    double height;
+    double decay;
+
+    /** rate for t in [start, end] */
+    double getSpikeRate(double t) const;
+
+public:
+    SpikeRate(double start, double duration, double height, double decay = 0);
+    virtual double getRate(double t) const;
+    virtual double getIntegral(double from, double to) const;
+    virtual double getMaxRate(double from, double to) const;
+    virtual double getNextBreakpoint(double t) const;
+};
+
+
+/**
+ * Sum of rate functions
+ */
+class SumRate : public RateFunction {
+    std::vector<std::unique_ptr<RateFunction>> terms;
+
+public:
+    void add(RateFunction* term);
+    virtual double getRate(double t) const;
+    virtual double getIntegral(double from, double to) const;
+    virtual double getMaxRate(double from, double to) const;
+    virtual double getNextBreakpoint(double t) const;
+};
+
+#endif /* RATEFUNCTIONS_H_ */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "TimeWindowQuantiles.h"
+
+using namespace std;
+
+template <class Clock>
+BasicTimeWindowQuantiles<Clock>::BasicTimeWindowQuantiles(unsigned subWindows, double relativeAccuracy) :
+        subWindows(max(subWindows, 1u), SubWindow { -1, QuantileSketch(relativeAccuracy) }),
+        windowSketch(relativeAccuracy),
+        lastExpiredIndex(-1) {
+    setWindow(60);
+}
+
+template <class Clock>
+void BasicTimeWindowQuantiles<Clock>::setWindow(unsigned seconds) {
+    subWindowWidth = Clock::divide(Clock::fromSeconds(seconds), subWindows.size());
+    for (auto& subWindow : subWindows) {
+        subWindow.index = -1;
+        subWindow.sketch.clear();
+    }
+    windowSketch.clear();
+    lastExpiredIndex = -1;
+}
+
+template <class Clock>
+long BasicTimeWindowQuantiles<Clock>::getSubWindowIndex(typename Clock::Timestamp t) const {
+    return Clock::getSlot(t, subWindowWidth);
+}
+
+template <class Clock>
+void BasicTimeWindowQuantiles<Clock>::expireSubWindows() {
+    long current = getSubWindowIndex(Clock::now());
+    if (current == lastExpiredIndex) {
+        return;
+    }
+
+    for (auto& subWindow : subWindows) {
+        if (subWindow.index >= 0 && subWindow.index <= current - (long) subWindows.size()) {
+            windowSketch.subtract(subWindow.sketch);
+            subWindow.sketch.clear();
+            subWindow.index = -1;
+        }
+    }
+    lastExpiredIndex = current;
+}
+
+template <class Clock>
+void BasicTimeWindowQuantiles<Clock>::record(double value) {
+    expireSubWindows();
+    long current = getSubWindowIndex(Clock::now());
+    SubWindow& subWindow = subWindows[current % subWindows.size()];
+    subWindow.index = current;
+    subWindow.sketch.record(value);
+    windowSketch.record(value);
+}
+
+template <class Clock>
+double BasicTimeWindowQuantiles<Clock>::getQuantile(double quantile) {
+    return getSketch().getQuantile(quantile);
+}
+
+template <class Clock>
+const QuantileSketch& BasicTimeWindowQuantiles<Clock>::getSketch() {
+    expireSubWindows();
+    return windowSketch;
+}
+
+template class BasicTimeWindowQuantiles<SimClock>;
+template class BasicTimeWindowQuantiles<SteadyClock>;
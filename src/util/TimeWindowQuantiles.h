@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef TIMEWINDOWQUANTILES_H_
+#define TIMEWINDOWQUANTILES_H_
+
+#include <vector>
+#include "Clocks.h"
+#include "QuantileSketch.h"
+
+/**
+ * Estimates quantiles of the values recorded in a sliding time window
+ *
+ * The window is divided into sub-windows, each with its own QuantileSketch,
+ * and a sketch with the sum of all of them is kept up to date as values are
+ * recorded and sub-windows expire. Memory is constant regardless of the
+ * event rate, and the window slides one sub-window at a time.
+ *
+ * @tparam Clock clock policy (see Clocks.h)
+ *
+ * @note This class is not thread-safe (intended for use in OMNET++)
+ */
+template <class Clock>
+class BasicTimeWindowQuantiles {
+public:
+    /**
+     * @param subWindows number of sub-windows the window is divided into
+     * @param relativeAccuracy max relative error of the quantiles
+     */
+    BasicTimeWindowQuantiles(unsigned subWindows = 12, double relativeAccuracy = 0.01);
+
+    void setWindow(unsigned seconds);
+    void record(double value);
+
+    /**
+     * @param quantile in [0, 1]
+     * @return estimated quantile of the values in the window (0 if none)
+     */
+    double getQuantile(double quantile);
+
+    /**
+     * @return sketch of the values in the window (e.g., for merging)
+     */
+    const QuantileSketch& getSketch();
+
+protected:
+    struct SubWindow {
+        long index; /**< absolute number of the time slot it holds (-1 if none) */
+        QuantileSketch sketch;
+    };
+
+    std::vector<SubWindow> subWindows;
+    QuantileSketch windowSketch; /**< sum of the sketches of the sub-windows */
+    typename Clock::Duration subWindowWidth;
+    long lastExpiredIndex;
+
+    long getSubWindowIndex(typename Clock::Timestamp t) const;
+
+    /**
+     * Removes the sub-windows that are no longer in the window
+     */
+    void expireSubWindows();
+};
+
+typedef BasicTimeWindowQuantiles<SimClock> TimeWindowQuantiles;
+typedef BasicTimeWindowQuantiles<SteadyClock> RealTimeWindowQuantiles;
+
+extern template class BasicTimeWindowQuantiles<SimClock>;
+extern template class BasicTimeWindowQuantiles<SteadyClock>;
+
+#endif /* TIMEWINDOWQUANTILES_H_ */
@@ -18,88 +18,104 @@
 
 using namespace std;
 
-TimeWindowStats::TimeWindowStats() {
+template <class Clock>
+BasicTimeWindowStats<Clock>::BasicTimeWindowStats() : start(Clock::now()) {
     setWindow(60);
 }
 
-TimeWindowStats::~TimeWindowStats() {
+template <class Clock>
+BasicTimeWindowStats<Clock>::~BasicTimeWindowStats() {
     // TODO Auto-generated destructor stub
 }
 
-void TimeWindowStats::reset() {
+template <class Clock>
+void BasicTimeWindowStats<Clock>::reset() {
     entries.clear();
-    pStats.reset(nullptr);
+    mean = 0;
+    m2 = 0;
+    start = getTimestampNow();
 }
 
-void TimeWindowStats::setWindow(unsigned seconds) {
-#if USE_OMNET_CLOCK
-    window = seconds;
-#else
-    window = std::chrono::seconds(seconds);
-#endif
+template <class Clock>
+void BasicTimeWindowStats<Clock>::setWindow(unsigned seconds) {
+    window = Clock::fromSeconds(seconds);
 }
 
 
-void TimeWindowStats::record(double value) {
+template <class Clock>
+void BasicTimeWindowStats<Clock>::record(double value) {
     if (entries.size() > ENTRIES_BETWEEN_CHECKS) {
         removeOldEntries();
     }
-    pStats.reset(nullptr);
     entries.push_back(Entry { getTimestampNow(), value });
+    addToStats(value);
     lastValue = value;
 }
 
 /**
- * Loads pStat with all the entries only if pStats == nullptr
- *
- * pStats is reset to nullptr every time the list of valid entries changes
+ * Updates the running statistics after value was appended to entries
  */
-void TimeWindowStats::loadStats() {
-    if (pStats == nullptr) {
-        pStats.reset(new Stats);
-        for (const auto& entry : entries) {
-            pStats->operator ()(entry.value);
-        }
-    }
+template <class Clock>
+void BasicTimeWindowStats<Clock>::addToStats(double value) {
+    double delta = value - mean;
+    mean += delta / entries.size();
+    m2 += delta * (value - mean);
 }
 
-double TimeWindowStats::getAverage() {
-    removeOldEntries();
-    double avg = 0.0;
+/**
+ * Updates the running statistics after value was removed from entries
+ */
+template <class Clock>
+void BasicTimeWindowStats<Clock>::removeFromStats(double value) {
+    if (entries.empty()) {
 
-    if (entries.size() > 0) {
-        loadStats();
-        avg = boost::accumulators::mean(*pStats);
+        /* start afresh so that rounding errors don't accumulate */
+        mean = 0;
+        m2 = 0;
+    } else {
+        double delta = value - mean;
+        mean -= delta / entries.size();
+        m2 -= delta * (value - mean);
+        if (m2 < 0) {
+            m2 = 0;
+        }
     }
+}
 
-    return avg;
+template <class Clock>
+double BasicTimeWindowStats<Clock>::getAverage() {
+    removeOldEntries();
+    return mean;
 }
 
-double TimeWindowStats::getVariance() {
+template <class Clock>
+double BasicTimeWindowStats<Clock>::getVariance() {
     removeOldEntries();
     double variance = 0.0;
 
     if (entries.size() > 0) {
-        loadStats();
-        variance = boost::accumulators::moment<2>(*pStats);
+        variance = m2 / entries.size();
     }
 
     return variance;
 }
 
-double TimeWindowStats::getRate() {
+template <class Clock>
+double BasicTimeWindowStats<Clock>::getRate() {
     removeOldEntries();
 
-    // TODO this works only for OMNeT++
-    return double(entries.size()) / min(asDouble(window), omnetpp::simTime().dbl());
+    double elapsed = asDouble(min(window, getTimestampNow() - start));
+    return (elapsed > 0) ? double(entries.size()) / elapsed : 0.0;
 }
 
-unsigned TimeWindowStats::getCount() {
+template <class Clock>
+unsigned BasicTimeWindowStats<Clock>::getCount() {
     removeOldEntries();
     return entries.size();
 }
 
-double TimeWindowStats::getPercentageAboveZero() {
+template <class Clock>
+double BasicTimeWindowStats<Clock>::getPercentageAboveZero() {
     removeOldEntries();
     if (entries.empty()) {
         return (lastValue > 0) ? 1.0 : 0.0;
@@ -134,16 +150,15 @@ double TimeWindowStats::getPercentageAboveZero() {
     return asDouble(busyTime) / asDouble(window);
 }
 
-void TimeWindowStats::removeOldEntries() {
-    bool entriesRemoved = false;
+template <class Clock>
+void BasicTimeWindowStats<Clock>::removeOldEntries() {
     auto windowStart = getTimestampNow() - window;
     while (!entries.empty() && entries.front().timestamp < windowStart) {
+        double value = entries.front().value;
         entries.pop_front();
-        entriesRemoved = true;
-    }
-
-    if (entriesRemoved) {
-        pStats.reset(nullptr);
+        removeFromStats(value);
     }
 }
 
+template class BasicTimeWindowStats<SimClock>;
+template class BasicTimeWindowStats<SteadyClock>;
@@ -17,72 +17,66 @@
 #define TIMEWINDOWSTATS_H_
 
 #include <deque>
-#include <memory>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/moment.hpp>
-
-#define USE_OMNET_CLOCK 1
-
-#if USE_OMNET_CLOCK
-#include <omnetpp.h>
-#else
-#include <chrono>
-#endif
+#include "Clocks.h"
+#include "WindowStats.h"
 
 /**
  * Computes statistics for events in a sliding time window
  *
+ * The mean and variance are maintained incrementally as entries are added
+ * and evicted (Welford's update with removal), so recording, evicting and
+ * querying are amortized O(1).
+ *
+ * @tparam Clock clock policy (see Clocks.h)
+ *
  * @note This class is not thread-safe (intended for use in OMNET++)
  */
-class TimeWindowStats {
+template <class Clock>
+class BasicTimeWindowStats : public WindowStats {
 public:
-    TimeWindowStats();
-    virtual ~TimeWindowStats();
+    BasicTimeWindowStats();
+    virtual ~BasicTimeWindowStats();
 
     virtual void reset();
     virtual void setWindow(unsigned seconds);
     virtual void record(double value);
     virtual double getAverage();
-    virtual double getVariance();
 
     /**
-     * Returns the average number of entries per second
+     * Returns the population variance of the values in the window, that is,
+     * the mean of the squared deviations from the mean
+     *
+     * @note Before the statistics were incremental, this returned the raw
+     * second moment (the mean of the squared values)
      */
+    virtual double getVariance();
     virtual double getRate();
     virtual unsigned getCount();
-
-    /**
-     * Assuming that entries set the new level for a continuous signal,
-     * it computes the percentage of time the signal was above 0.
-     *
-     * TODO this probably should be a specialization for boolean values
-     */
     virtual double getPercentageAboveZero();
 
 protected:
-    typedef boost::accumulators::accumulator_set<double,
-            boost::accumulators::stats<boost::accumulators::tag::mean,
-                    boost::accumulators::tag::moment<2> > > Stats;
-    std::unique_ptr<Stats> pStats;
-
-    void loadStats();
-
-#if USE_OMNET_CLOCK
-    using Duration = omnetpp::simtime_t;
-    using Timestamp = omnetpp::simtime_t;
-#else
-    using clock = std::chrono::system_clock;
-    using Duration = clock::duration;
-    using Timestamp = clock::time_point;
-#endif
+
+    /* running statistics of the values in entries */
+    double mean = 0;
+    double m2 = 0; /**< sum of squared differences from the mean */
+
+    void addToStats(double value);
+    void removeFromStats(double value);
+
+    using Duration = typename Clock::Duration;
+    using Timestamp = typename Clock::Timestamp;
 
     /**
      * Window duration
      */
     Duration window;
 
+    /**
+     * When the collection of statistics started (for the rate before a
+     * whole window has elapsed)
+     */
+    Timestamp start;
+
     struct Entry {
         Timestamp timestamp;
         double value;
@@ -106,24 +100,20 @@ protected:
         return t - d;
     }
 
-#if USE_OMNET_CLOCK
-    inline Timestamp getTimestampNow() const {
-        return omnetpp::simTime();
-    }
-
-    inline double asDouble(Duration t) const {
-        return t.dbl();
-    }
-#else
     inline Timestamp getTimestampNow() const {
-        return clock::now();
+        return Clock::now();
     }
 
     inline double asDouble(Duration t) const {
-        return std::chrono::duration<double>(t).count();
+        return Clock::toSeconds(t);
     }
-#endif
 
 };
 
+typedef BasicTimeWindowStats<SimClock> TimeWindowStats;
+typedef BasicTimeWindowStats<SteadyClock> RealTimeWindowStats;
+
+extern template class BasicTimeWindowStats<SimClock>;
+extern template class BasicTimeWindowStats<SteadyClock>;
+
 #endif /* TIMEWINDOWSTATS_H_ */
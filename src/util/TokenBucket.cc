@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "TokenBucket.h"
+#include <algorithm>
+
+TokenBucket::TokenBucket() : rate(0), burst(1), tokens(1), lastRefill(0) {
+}
+
+void TokenBucket::setRate(double rate, double burst) {
+    ASSERT(rate >= 0 && burst >= 1);
+
+    // account for the tokens accumulated at the old rate
+    refill();
+
+    this->rate = rate;
+    this->burst = burst;
+    tokens = std::min(tokens, burst);
+}
+
+double TokenBucket::getRate() const {
+    return rate;
+}
+
+void TokenBucket::refill() {
+    omnetpp::simtime_t now = omnetpp::simTime();
+    if (rate == 0) {
+        tokens = burst;
+    } else {
+        tokens = std::min(burst, tokens + rate * (now - lastRefill).dbl());
+    }
+    lastRefill = now;
+}
+
+bool TokenBucket::admit() {
+    refill();
+    if (rate == 0) {
+        return true;
+    }
+    if (tokens < 1) {
+        return false;
+    }
+    tokens -= 1;
+    return true;
+}
+
+void TokenBucket::refund() {
+    if (rate > 0) {
+        tokens = std::min(burst, tokens + 1);
+    }
+}
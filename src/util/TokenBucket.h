@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef TOKENBUCKET_H_
+#define TOKENBUCKET_H_
+
+#include <omnetpp.h>
+
+/**
+ * Token bucket rate limiter driven by the simulation clock
+ *
+ * Tokens are added at the configured rate up to the burst size, and each
+ * admitted request takes one token.
+ */
+class TokenBucket {
+    double rate; /**<- tokens per second (0 for no limit) */
+    double burst; /**<- max number of tokens */
+    double tokens;
+    omnetpp::simtime_t lastRefill;
+
+    /**
+     * Adds the tokens accumulated since the last refill
+     */
+    void refill();
+
+public:
+    TokenBucket();
+
+    /**
+     * @param rate tokens per second. If 0, all requests are admitted
+     * @param burst max number of tokens (i.e., requests admitted back to back)
+     */
+    void setRate(double rate, double burst);
+
+    double getRate() const;
+
+    /**
+     * Takes a token if there is one available
+     *
+     * @return true if the request is admitted
+     */
+    bool admit();
+
+    /**
+     * Gives back the token taken by admit(), for a request that was admitted
+     * but then rejected for another reason
+     */
+    void refund();
+};
+
+#endif /* TOKENBUCKET_H_ */
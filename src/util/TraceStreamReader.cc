@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "TraceStreamReader.h"
+#include <cstdlib>
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace std;
+
+const unsigned GZ_BUFFER_SIZE = 256 * 1024;
+const int MAX_LINE_LENGTH = 256;
+
+TraceStreamReader::TraceStreamReader(const std::string& path, size_t chunkSize, unsigned buffers)
+    : path(path), chunkSize(chunkSize), ring(buffers), head(0), filled(0),
+      finished(false), stopping(false) {
+    if (chunkSize == 0 || buffers == 0) {
+        throw invalid_argument("TraceStreamReader chunkSize and buffers must be positive");
+    }
+
+    // gzopen() also reads files that are not compressed
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file) {
+        throw runtime_error("TraceStreamReader could not open '" + path + "'");
+    }
+    gzbuffer(file, GZ_BUFFER_SIZE);
+    for (auto& buffer : ring) {
+        buffer.reserve(chunkSize);
+    }
+    readerThread = thread(&TraceStreamReader::readTrace, this, file);
+}
+
+TraceStreamReader::~TraceStreamReader() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    notFull.notify_one();
+    readerThread.join();
+}
+
+bool TraceStreamReader::readChunk(std::vector<double>& chunk) {
+    unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this] { return filled > 0 || finished; });
+    if (filled == 0) {
+        if (!errorMessage.empty()) {
+            throw runtime_error(errorMessage);
+        }
+        chunk.clear();
+        return false;
+    }
+
+    chunk.swap(ring[head]);
+    ring[head].clear();
+    head = (head + 1) % ring.size();
+    filled--;
+    lock.unlock();
+    notFull.notify_one();
+    return true;
+}
+
+/*
+ * Runs in the reader thread. The values are parsed into a local chunk
+ * without holding the lock, which is only taken to swap it into the ring
+ */
+void TraceStreamReader::readTrace(void* file) {
+    gzFile trace = static_cast<gzFile>(file);
+    vector<double> chunk;
+    chunk.reserve(chunkSize);
+    unsigned tail = 0;
+    char line[MAX_LINE_LENGTH];
+    bool endOfTrace = false;
+    string error;
+
+    while (!endOfTrace) {
+        while (chunk.size() < chunkSize) {
+            if (!gzgets(trace, line, sizeof(line))) {
+                int errorNumber;
+                gzerror(trace, &errorNumber);
+                if (errorNumber != Z_OK && errorNumber != Z_STREAM_END) {
+                    error = "TraceStreamReader could not read '" + path + "'";
+                }
+                endOfTrace = true;
+                break;
+            }
+            char* end;
+            double value = strtod(line, &end);
+            if (end != line) {
+                chunk.push_back(value);
+            }
+        }
+
+        unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return filled < ring.size() || stopping; });
+        if (stopping) {
+            break;
+        }
+        if (!chunk.empty()) {
+            chunk.swap(ring[tail]);
+            tail = (tail + 1) % ring.size();
+            filled++;
+        }
+        if (endOfTrace) {
+            finished = true;
+            errorMessage = error;
+        }
+        lock.unlock();
+        notEmpty.notify_one();
+    }
+    gzclose(trace);
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef TRACESTREAMREADER_H_
+#define TRACESTREAMREADER_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Reads a trace with one value per line in a background thread
+ *
+ * The file can be gzip-compressed or plain text. The reader thread parses
+ * the values in chunks into a ring of buffers, and stays ahead of the
+ * consumer by at most the size of the ring, so the memory used does not
+ * depend on the length of the trace. The consumer only waits if the
+ * reader thread falls behind.
+ *
+ * @note Only one thread can consume the chunks
+ */
+class TraceStreamReader {
+public:
+    /**
+     * Starts the reader thread
+     *
+     * @param chunkSize number of values in each chunk
+     * @param buffers number of chunks in the ring (2 for double buffering)
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    TraceStreamReader(const std::string& path, size_t chunkSize, unsigned buffers = 2);
+    virtual ~TraceStreamReader();
+
+    /**
+     * Gets the next chunk of values
+     *
+     * The contents of chunk are swapped with the buffer in the ring, so that
+     * the consumer and the reader thread reuse their memory.
+     *
+     * @return false if there are no more values in the trace
+     * @throws std::runtime_error if the trace could not be read
+     */
+    bool readChunk(std::vector<double>& chunk);
+
+protected:
+    const std::string path;
+    const size_t chunkSize;
+
+    std::vector<std::vector<double>> ring;
+    unsigned head; /**< next buffer to be consumed */
+    unsigned filled; /**< number of buffers ready to be consumed */
+    bool finished; /**< the reader thread finished reading the trace */
+    bool stopping; /**< the reader thread must stop */
+    std::string errorMessage;
+
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::thread readerThread;
+
+    void readTrace(void* file);
+
+private:
+    TraceStreamReader(const TraceStreamReader&) = delete;
+    TraceStreamReader& operator=(const TraceStreamReader&) = delete;
+};
+
+#endif /* TRACESTREAMREADER_H_ */
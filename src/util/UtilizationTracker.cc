@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#include "UtilizationTracker.h"
+
+template <class Clock>
+BasicUtilizationTracker<Clock>::BasicUtilizationTracker() {
+    setWindow(60);
+}
+
+template <class Clock>
+void BasicUtilizationTracker<Clock>::setWindow(unsigned seconds) {
+    window = Clock::fromSeconds(seconds);
+}
+
+template <class Clock>
+void BasicUtilizationTracker<Clock>::setBusy(bool busy) {
+    if (!transitions.empty() && transitions.back().busy == busy) {
+        return;
+    }
+
+    auto now = Clock::now();
+    Duration busyTime(0);
+    if (!transitions.empty()) {
+        busyTime = getBusyTime(transitions.back(), now);
+    }
+    transitions.push_back(Transition { now, busyTime, busy });
+    removeOldTransitions();
+}
+
+template <class Clock>
+typename BasicUtilizationTracker<Clock>::Duration BasicUtilizationTracker<Clock>::getBusyTime(const Transition& transition, Timestamp t) const {
+    Duration busyTime = transition.busyTime;
+    if (transition.busy) {
+        busyTime += t - transition.timestamp;
+    }
+    return busyTime;
+}
+
+template <class Clock>
+void BasicUtilizationTracker<Clock>::removeOldTransitions() {
+    auto windowStart = Clock::now() - window;
+    while (transitions.size() > 1 && transitions[1].timestamp <= windowStart) {
+        transitions.pop_front();
+    }
+}
+
+template <class Clock>
+double BasicUtilizationTracker<Clock>::getUtilization() {
+    if (transitions.empty()) {
+        return 0.0;
+    }
+    removeOldTransitions();
+
+    auto now = Clock::now();
+    auto windowStart = now - window;
+
+    // with no transition before the window, the signal was idle at its start
+    Duration busyTimeAtStart(0);
+    const auto& first = transitions.front();
+    if (first.timestamp <= windowStart) {
+        busyTimeAtStart = getBusyTime(first, windowStart);
+    }
+
+    return Clock::toSeconds(getBusyTime(transitions.back(), now) - busyTimeAtStart) / Clock::toSeconds(window);
+}
+
+template class BasicUtilizationTracker<SimClock>;
+template class BasicUtilizationTracker<SteadyClock>;
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+
+#ifndef UTILIZATIONTRACKER_H_
+#define UTILIZATIONTRACKER_H_
+
+#include <deque>
+#include "Clocks.h"
+
+/**
+ * Computes the percentage of time a busy/idle signal was busy in a sliding
+ * time window
+ *
+ * It keeps the busy/idle transitions with the cumulative busy time at each,
+ * so the busy time in the window is the difference between the cumulative
+ * busy time now and at the start of the window. Updates and queries are
+ * amortized O(1).
+ *
+ * @tparam Clock clock policy (see Clocks.h)
+ *
+ * @note This class is not thread-safe (intended for use in OMNET++)
+ */
+template <class Clock>
+class BasicUtilizationTracker {
+public:
+    BasicUtilizationTracker();
+
+    void setWindow(unsigned seconds);
+
+    /**
+     * Records a change in the signal (repeated values are ignored)
+     */
+    void setBusy(bool busy);
+
+    /**
+     * Returns the fraction of the window in which the signal was busy
+     */
+    double getUtilization();
+
+protected:
+    using Duration = typename Clock::Duration;
+    using Timestamp = typename Clock::Timestamp;
+
+    struct Transition {
+        Timestamp timestamp;
+        Duration busyTime; /**< cumulative busy time up to timestamp */
+        bool busy;
+    };
+
+    /** window duration */
+    Duration window;
+
+    std::deque<Transition> transitions;
+
+    /**
+     * Returns the cumulative busy time up to t
+     *
+     * @param transition the last transition at or before t
+     */
+    Duration getBusyTime(const Transition& transition, Timestamp t) const;
+
+    /**
+     * Removes the transitions before the window, except the last one, which
+     * gives the state at the start of the window
+     */
+    void removeOldTransitions();
+};
+
+typedef BasicUtilizationTracker<SimClock> UtilizationTracker;
+typedef BasicUtilizationTracker<SteadyClock> RealUtilizationTracker;
+
+extern template class BasicUtilizationTracker<SimClock>;
+extern template class BasicUtilizationTracker<SteadyClock>;
+
+#endif /* UTILIZATIONTRACKER_H_ */
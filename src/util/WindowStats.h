@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+#ifndef WINDOWSTATS_H_
+#define WINDOWSTATS_H_
+
+/**
+ * Interface of the statistics of events in a sliding time window
+ *
+ * @see TimeWindowStats, BucketedTimeWindowStats
+ */
+class WindowStats {
+public:
+    virtual ~WindowStats() {}
+
+    virtual void reset() = 0;
+    virtual void setWindow(unsigned seconds) = 0;
+    virtual void record(double value) = 0;
+    virtual double getAverage() = 0;
+
+    /**
+     * Returns the population variance of the values in the window
+     */
+    virtual double getVariance() = 0;
+
+    /**
+     * Returns the average number of entries per second
+     */
+    virtual double getRate() = 0;
+    virtual unsigned getCount() = 0;
+
+    /**
+     * Assuming that entries set the new level for a continuous signal,
+     * it computes the percentage of time the signal was above 0.
+     *
+     * @see UtilizationTracker for busy/idle signals
+     */
+    virtual double getPercentageAboveZero() = 0;
+};
+
+#endif /* WINDOWSTATS_H_ */
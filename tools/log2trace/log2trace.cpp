@@ -0,0 +1,540 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+#include "util/BinaryTrace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Converts web server access logs to a trace of arrivals for the simulation
+ *
+ * The logs are parsed in parallel, each thread taking a chunk of the file
+ * and counting the requests in each second, and the counts of the chunks
+ * are added up. Since the logs have a resolution of one second, the arrivals within each second are spread at
+ * random (or evenly). The arrivals can be resampled to a target peak rate
+ * and sliced to a time window, and are written as a .delta trace (one
+ * interarrival time per line) or as a binary trace (see BinaryTrace).
+ */
+
+enum class Format { CLF, WORLDCUP };
+
+struct Options {
+    Format format = Format::CLF;
+    unsigned threads = 0;
+    double offset = 0; /**< start of the slice from the first request */
+    double duration = 0; /**< 0 for the rest of the log */
+    double peakRate = 0; /**< 0 to keep the rate */
+    double factor = 1;
+    unsigned peakWindow = 60;
+    unsigned long seed = 0;
+    bool even = false;
+};
+
+/** size of a record of the binary WorldCup98 logs */
+const size_t WORLDCUP_RECORD_SIZE = 20;
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [options] output.delta|output.bin log..." << endl;
+    cerr << "  -f clf|worldcup  format of the logs (default clf, i.e., Common Log Format)" << endl;
+    cerr << "  -j threads       parsing threads (default: number of cores)" << endl;
+    cerr << "  -o offset        start of the slice from the first request, e.g., 2h (default 0)" << endl;
+    cerr << "  -d duration      length of the slice, e.g., 105m (default: to the end of the log)" << endl;
+    cerr << "  -p rate          resample the arrivals so that the peak rate is this many requests/s" << endl;
+    cerr << "  -x factor        resample the arrivals multiplying the rate by factor" << endl;
+    cerr << "  -w seconds       window over which the peak rate is measured (default 60)" << endl;
+    cerr << "  -r seed          seed for spreading and resampling the arrivals (default 0)" << endl;
+    cerr << "  -e               spread the arrivals evenly within each second instead of at random" << endl;
+    cerr << "durations are in seconds unless followed by s, m, h, or d" << endl;
+}
+
+bool parseDuration(const char* text, double& seconds) {
+    char* end;
+    seconds = strtod(text, &end);
+    switch (*end) {
+    case '\0': case 's': break;
+    case 'm': seconds *= 60; break;
+    case 'h': seconds *= 3600; break;
+    case 'd': seconds *= 86400; break;
+    default: return false;
+    }
+    return end[0] == '\0' || end[1] == '\0';
+}
+
+/**
+ * Read-only memory mapping of a whole file
+ */
+class MappedFile {
+public:
+    const char* data = nullptr;
+    size_t size = 0;
+
+    explicit MappedFile(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error(string("could not read log file '") + path + "'");
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw runtime_error(string("could not read log file '") + path + "'");
+        }
+        size = st.st_size;
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw runtime_error(string("could not map log file '") + path + "'");
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+/**
+ * Days since 1970-01-01 of a date in the proleptic Gregorian calendar
+ */
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= (month <= 2);
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+inline bool parseNumber(const char*& p, const char* end, unsigned digits, int& value) {
+    value = 0;
+    for (unsigned d = 0; d < digits; d++, p++) {
+        if (p >= end || *p < '0' || *p > '9') {
+            return false;
+        }
+        value = value * 10 + (*p - '0');
+    }
+    return true;
+}
+
+/**
+ * Parses the timestamp of a Common Log Format line, which looks like
+ *   host ident user [10/Oct/2000:13:55:36 -0700] "GET / HTTP/1.0" 200 2326
+ *
+ * @return false if the line does not have a valid timestamp
+ */
+bool parseClfTimestamp(const char* p, const char* end, int64_t& timestamp) {
+    static const char* MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    p = static_cast<const char*>(memchr(p, '[', end - p));
+    if (p == nullptr || end - p < 27) {
+        return false;
+    }
+    p++;
+
+    int day, year, hour, minute, second, zoneHours, zoneMinutes;
+    if (!parseNumber(p, end, 2, day) || *p++ != '/') {
+        return false;
+    }
+    unsigned month = 1;
+    while (month <= 12 && memcmp(p, MONTHS + (month - 1) * 3, 3) != 0) {
+        month++;
+    }
+    if (month > 12) {
+        return false;
+    }
+    p += 3;
+    if (*p++ != '/' || !parseNumber(p, end, 4, year) || *p++ != ':'
+            || !parseNumber(p, end, 2, hour) || *p++ != ':'
+            || !parseNumber(p, end, 2, minute) || *p++ != ':'
+            || !parseNumber(p, end, 2, second) || *p++ != ' ') {
+        return false;
+    }
+    char zoneSign = *p++;
+    if ((zoneSign != '+' && zoneSign != '-') || !parseNumber(p, end, 2, zoneHours)
+            || !parseNumber(p, end, 2, zoneMinutes)) {
+        return false;
+    }
+
+    int64_t zoneOffset = (zoneHours * 3600 + zoneMinutes * 60) * ((zoneSign == '-') ? -1 : 1);
+    timestamp = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - zoneOffset;
+    return true;
+}
+
+/**
+ * Number of requests in each second, from the first to the last one seen
+ */
+struct Histogram {
+    int64_t first = 0; /**< second of counts[0] */
+    vector<uint32_t> counts;
+
+    int64_t end() const {
+        return first + (int64_t) counts.size();
+    }
+
+    void add(int64_t second, uint32_t count = 1) {
+        if (counts.empty()) {
+            first = second;
+        } else if (second < first) {
+
+            // grow at the front geometrically, since logs are only roughly in time order
+            size_t grow = max<size_t>(first - second, counts.size());
+            counts.insert(counts.begin(), grow, 0);
+            first -= grow;
+        }
+        size_t index = second - first;
+        if (index >= counts.size()) {
+            counts.resize(index + 1);
+        }
+        counts[index] += count;
+    }
+
+    /** removes the empty seconds at the front left by add() */
+    void trim() {
+        auto firstRequest = find_if(counts.begin(), counts.end(), [](uint32_t c) { return c > 0; });
+        first += firstRequest - counts.begin();
+        counts.erase(counts.begin(), firstRequest);
+    }
+};
+
+/**
+ * Requests per second in a chunk of a log
+ */
+struct Chunk {
+    Histogram requests;
+    size_t skipped = 0; /**< lines that could not be parsed */
+};
+
+void parseClfChunk(const char* begin, const char* end, Chunk& chunk) {
+    const char* line = begin;
+    while (line < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        int64_t timestamp;
+        if (parseClfTimestamp(line, lineEnd, timestamp)) {
+            chunk.requests.add(timestamp);
+        } else if (lineEnd > line) {
+            chunk.skipped++;
+        }
+        line = lineEnd + 1;
+    }
+    chunk.requests.trim();
+}
+
+/*
+ * The records of the WorldCup98 logs are big-endian: timestamp, clientID,
+ * objectID, size (32 bits each), and method, status, type, server (8 bits)
+ */
+void parseWorldCupChunk(const char* begin, const char* end, Chunk& chunk) {
+    for (const char* record = begin; record + WORLDCUP_RECORD_SIZE <= end; record += WORLDCUP_RECORD_SIZE) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(record);
+        uint32_t timestamp = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16)
+                | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+        chunk.requests.add(timestamp);
+    }
+    chunk.requests.trim();
+}
+
+/**
+ * Parses a log with one thread per chunk, appending a chunk per thread
+ */
+void parseLog(const char* path, const Options& options, vector<Chunk>& chunks) {
+    MappedFile file(path);
+    if (options.format == Format::WORLDCUP && file.size % WORLDCUP_RECORD_SIZE != 0) {
+        throw runtime_error(string("'") + path + "' is not a WorldCup98 binary log");
+    }
+
+    // chunk boundaries, at the end of a line or of a record
+    vector<const char*> boundaries;
+    const char* fileEnd = file.data + file.size;
+    boundaries.push_back(file.data);
+    for (unsigned t = 1; t < options.threads; t++) {
+        size_t position = file.size * t / options.threads;
+        const char* boundary;
+        if (options.format == Format::WORLDCUP) {
+            boundary = file.data + position - position % WORLDCUP_RECORD_SIZE;
+        } else {
+            boundary = static_cast<const char*>(memchr(file.data + position, '\n', file.size - position));
+            boundary = (boundary) ? boundary + 1 : fileEnd;
+        }
+        boundaries.push_back(max(boundary, boundaries.back()));
+    }
+    boundaries.push_back(fileEnd);
+
+    size_t first = chunks.size();
+    chunks.resize(first + options.threads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < options.threads; t++) {
+        Chunk& chunk = chunks[first + t];
+        workers.emplace_back((options.format == Format::WORLDCUP) ? parseWorldCupChunk : parseClfChunk,
+                boundaries[t], boundaries[t + 1], std::ref(chunk));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Adds up the requests per second of the chunks
+ */
+Histogram mergeChunks(vector<Chunk>& chunks) {
+    Histogram requests;
+    int64_t end = 0;
+    bool empty = true;
+    for (const auto& chunk : chunks) {
+        const Histogram& h = chunk.requests;
+        if (!h.counts.empty()) {
+            requests.first = (empty) ? h.first : min(requests.first, h.first);
+            end = (empty) ? h.end() : max(end, h.end());
+            empty = false;
+        }
+    }
+    requests.counts.resize(end - requests.first);
+    for (auto& chunk : chunks) {
+        const Histogram& h = chunk.requests;
+        for (size_t s = 0; s < h.counts.size(); s++) {
+            requests.counts[h.first - requests.first + s] += h.counts[s];
+        }
+        vector<uint32_t>().swap(chunk.requests.counts);
+    }
+    return requests;
+}
+
+/**
+ * Writes the arrival times as a .delta or a binary trace
+ */
+class TraceOutput {
+    bool binary;
+    ofstream deltaOut;
+    BinaryTraceWriter binaryOut;
+    double lastArrivalTime = 0;
+
+public:
+    explicit TraceOutput(const string& path) {
+        binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+        if (binary) {
+            binaryOut.open(path);
+        } else {
+            deltaOut.open(path, ios::trunc);
+            if (!deltaOut) {
+                throw runtime_error("could not write output file '" + path + "'");
+            }
+            deltaOut << setprecision(15);
+        }
+    }
+
+    void append(double arrivalTime) {
+        if (binary) {
+            binaryOut.append(arrivalTime);
+        } else {
+            deltaOut << arrivalTime - lastArrivalTime << '\n';
+        }
+        lastArrivalTime = arrivalTime;
+    }
+
+    void close() {
+        if (binary) {
+            binaryOut.close();
+        } else {
+            deltaOut.close();
+            if (!deltaOut) {
+                throw runtime_error("could not write output file");
+            }
+        }
+    }
+};
+
+int convert(const char* outputPath, const vector<const char*>& logPaths, Options options) {
+    vector<Chunk> chunks;
+    for (auto path : logPaths) {
+        parseLog(path, options, chunks);
+    }
+    size_t skipped = 0;
+    for (const auto& chunk : chunks) {
+        skipped += chunk.skipped;
+    }
+    Histogram requests = mergeChunks(chunks);
+    if (requests.counts.empty()) {
+        cerr << "no requests found in the logs" << endl;
+        return EXIT_FAILURE;
+    }
+
+    // requests in each second of the slice
+    int64_t sliceStart = requests.first + (int64_t) options.offset;
+    int64_t sliceEnd = (options.duration > 0) ? sliceStart + (int64_t) ceil(options.duration) : requests.end();
+    if (sliceEnd <= sliceStart) {
+        cerr << "the slice starts after the end of the logs" << endl;
+        return EXIT_FAILURE;
+    }
+    vector<uint32_t> counts(sliceEnd - sliceStart);
+    for (int64_t s = sliceStart; s < min(sliceEnd, requests.end()); s++) {
+        counts[s - sliceStart] = requests.counts[s - requests.first];
+    }
+    vector<uint32_t>().swap(requests.counts);
+
+    // peak rate over the windows of the slice
+    uint64_t peakCount = 0;
+    for (size_t windowStart = 0; windowStart < counts.size(); windowStart += options.peakWindow) {
+        size_t windowEnd = min(counts.size(), windowStart + options.peakWindow);
+        uint64_t windowCount = 0;
+        for (size_t s = windowStart; s < windowEnd; s++) {
+            windowCount += counts[s];
+        }
+        peakCount = max(peakCount, windowCount);
+    }
+    double peakRate = double(peakCount) / options.peakWindow;
+    if (options.peakRate > 0) {
+        if (peakRate == 0) {
+            cerr << "there are no requests in the slice" << endl;
+            return EXIT_FAILURE;
+        }
+        options.factor = options.peakRate / peakRate;
+    }
+
+    /*
+     * each request is replaced by floor(factor) arrivals, plus one with
+     * probability equal to the fractional part of factor
+     */
+    mt19937_64 generator(options.seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    double copies = floor(options.factor);
+    double extraProbability = options.factor - copies;
+    vector<double> offsets;
+    uint64_t arrivals = 0;
+    TraceOutput output(outputPath);
+    for (size_t s = 0; s < counts.size(); s++) {
+        uint64_t count = counts[s] * (uint64_t) copies;
+        if (extraProbability > 0 && counts[s] > 0) {
+            count += binomial_distribution<uint64_t>(counts[s], extraProbability)(generator);
+        }
+
+        offsets.resize(count);
+        for (uint64_t a = 0; a < count; a++) {
+            offsets[a] = (options.even) ? (a + 0.5) / count : uniform(generator);
+        }
+        if (!options.even) {
+            sort(offsets.begin(), offsets.end());
+        }
+        for (double offset : offsets) {
+            output.append(s + offset);
+        }
+        arrivals += count;
+    }
+    output.close();
+
+    cout << "requests in the slice: " << accumulate(counts.begin(), counts.end(), uint64_t(0)) << endl;
+    if (skipped > 0) {
+        cout << "lines skipped: " << skipped << endl;
+    }
+    cout << "peak rate: " << peakRate << " -> " << peakRate * options.factor << " requests/s" << endl;
+    cout << "wrote " << arrivals << " arrivals to " << outputPath << endl;
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:j:o:d:p:x:w:r:e")) != -1) {
+        bool valid = true;
+        switch (opt) {
+        case 'f':
+            if (strcmp(optarg, "clf") == 0) {
+                options.format = Format::CLF;
+            } else if (strcmp(optarg, "worldcup") == 0) {
+                options.format = Format::WORLDCUP;
+            } else {
+                valid = false;
+            }
+            break;
+        case 'j': {
+            int threads = atoi(optarg);
+            valid = threads > 0;
+            options.threads = threads;
+            break;
+        }
+        case 'o':
+            valid = parseDuration(optarg, options.offset) && options.offset >= 0;
+            break;
+        case 'd':
+            valid = parseDuration(optarg, options.duration) && options.duration >= 0;
+            break;
+        case 'p':
+            options.peakRate = atof(optarg);
+            valid = options.peakRate > 0;
+            break;
+        case 'x':
+            options.factor = atof(optarg);
+            valid = options.factor > 0;
+            break;
+        case 'w':
+            options.peakWindow = atoi(optarg);
+            valid = options.peakWindow > 0;
+            break;
+        case 'r':
+            options.seed = strtoul(optarg, nullptr, 10);
+            break;
+        case 'e':
+            options.even = true;
+            break;
+        default:
+            valid = false;
+        }
+        if (!valid) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind + 2 > argc) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (options.threads == 0) {
+        options.threads = max(1u, thread::hardware_concurrency());
+    }
+
+    vector<const char*> logPaths(argv + optind + 1, argv + argc);
+    try {
+        return convert(argv[optind], logPaths, options);
+    } catch (const std::runtime_error& e) {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+#include "util/BinaryTrace.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Converts a .delta trace (one interarrival time per line) to the binary
+ * trace format that PredictableSource maps in memory
+ */
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [-s scale] input.delta output.bin" << endl;
+    cerr << "       " << program << " -c trace.bin" << endl;
+    cerr << "  -s scale  factor to convert the interarrival times to seconds (default 1)" << endl;
+    cerr << "  -c        check a binary trace and print its header" << endl;
+}
+
+int convert(const char* inputPath, const char* outputPath, double scale) {
+    ifstream fin(inputPath);
+    if (!fin) {
+        cerr << "could not read input file '" << inputPath << "'" << endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<double> arrivalTimes;
+    double arrivalTime = 0;
+    double timeValue;
+    while (fin >> timeValue) {
+        if (timeValue < 0) {
+            cerr << "negative interarrival time at line " << arrivalTimes.size() + 1 << endl;
+            return EXIT_FAILURE;
+        }
+        arrivalTime += timeValue;
+        arrivalTimes.push_back(arrivalTime);
+    }
+    if (!fin.eof()) {
+        cerr << "invalid value at line " << arrivalTimes.size() + 1 << endl;
+        return EXIT_FAILURE;
+    }
+
+    ofstream fout(outputPath, ios::binary | ios::trunc);
+    BinaryTrace::write(fout, arrivalTimes, scale);
+    fout.close();
+    if (!fout) {
+        cerr << "could not write output file '" << outputPath << "'" << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "wrote " << arrivalTimes.size() << " arrivals to " << outputPath << endl;
+    return EXIT_SUCCESS;
+}
+
+int check(const char* path) {
+    BinaryTrace trace;
+    try {
+        trace.open(path);
+    } catch (const std::runtime_error& e) {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    cout << "version: " << BinaryTrace::VERSION << endl;
+    cout << "scale: " << trace.getScale() << endl;
+    cout << "count: " << trace.size() << endl;
+    if (trace.size() > 0) {
+        cout << "duration: " << trace.getArrivalTimes()[trace.size() - 1] * trace.getScale() << endl;
+    }
+    bool valid = trace.verifyChecksum();
+    cout << "checksum: " << ((valid) ? "ok" : "mismatch") << endl;
+    return (valid) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    double scale = 1;
+    bool checkOnly = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:c")) != -1) {
+        switch (opt) {
+        case 's':
+            scale = atof(optarg);
+            break;
+        case 'c':
+            checkOnly = true;
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (checkOnly && optind + 1 == argc) {
+        return check(argv[optind]);
+    } else if (!checkOnly && optind + 2 == argc) {
+        return convert(argv[optind], argv[optind + 1], scale);
+    }
+    usage(argv[0]);
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * Simulator of Web Infrastructure and Management
+ * Copyright (c) 2016 Carnegie Mellon University.
+ * All Rights Reserved.
+ *  
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITH NO WARRANTIES WHATSOEVER. CARNEGIE
+ * MELLON UNIVERSITY EXPRESSLY DISCLAIMS TO THE FULLEST EXTENT PERMITTED BY LAW
+ * ALL EXPRESS, IMPLIED, AND STATUTORY WARRANTIES, INCLUDING, WITHOUT
+ * LIMITATION, THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, AND NON-INFRINGEMENT OF PROPRIETARY RIGHTS.
+ *  
+ * Released under a BSD license, please see license.txt for full terms.
+ * DM-0003883
+ *******************************************************************************/
+/*
+ * Checks the incremental statistics of the window stats classes against a
+ * brute-force recomputation over random sequences of records and evictions
+ *
+ * The classes are instantiated with a manual clock, so time only moves
+ * when the test advances it.
+ */
+#include "util/TimeWindowStats.cc"
+#include "util/BucketedTimeWindowStats.cc"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Clock policy whose time is set by the test
+ */
+struct ManualClock {
+    using Duration = double;
+    using Timestamp = double;
+
+    static Timestamp current;
+
+    static Timestamp now() {
+        return current;
+    }
+
+    static Duration fromSeconds(unsigned seconds) {
+        return seconds;
+    }
+
+    static double toSeconds(Duration d) {
+        return d;
+    }
+
+    static Timestamp fromEpoch(Duration d) {
+        return d;
+    }
+
+    static Duration divide(Duration d, unsigned n) {
+        return d / n;
+    }
+
+    static Duration multiply(Duration d, long n) {
+        return d * n;
+    }
+
+    static long getSlot(Timestamp t, Duration width) {
+        return (long) floor(t / width);
+    }
+};
+
+ManualClock::Timestamp ManualClock::current = 0;
+
+template class BasicTimeWindowStats<ManualClock>;
+template class BasicBucketedTimeWindowStats<ManualClock>;
+
+namespace {
+
+const unsigned WINDOW = 10; /**< seconds */
+
+struct Entry {
+    double timestamp;
+    double value;
+};
+
+/**
+ * Tells if an entry with the given timestamp is in the window at time now
+ */
+typedef function<bool(double timestamp, double now)> InWindow;
+
+/**
+ * Brute-force statistics of the entries in the window
+ */
+struct Expected {
+    unsigned count = 0;
+    double mean = 0;
+    double variance = 0;
+
+    Expected(const vector<Entry>& entries, InWindow inWindow, double now) {
+        double sum = 0;
+        for (const auto& entry : entries) {
+            if (inWindow(entry.timestamp, now)) {
+                count++;
+                sum += entry.value;
+            }
+        }
+        if (count > 0) {
+            mean = sum / count;
+            double sumOfSquares = 0;
+            for (const auto& entry : entries) {
+                if (inWindow(entry.timestamp, now)) {
+                    sumOfSquares += (entry.value - mean) * (entry.value - mean);
+                }
+            }
+            variance = sumOfSquares / count;
+        }
+    }
+};
+
+unsigned failures = 0;
+
+void check(const char* name, const char* what, double actual, double expected, double scale,
+        unsigned run, unsigned step) {
+    const double TOLERANCE = 1e-6;
+    if (fabs(actual - expected) > TOLERANCE * max(1.0, scale)) {
+        if (failures++ < 10) {
+            cerr << name << " run " << run << " step " << step << ": " << what
+                    << " is " << actual << ", expected " << expected << endl;
+        }
+    }
+}
+
+/**
+ * Records random values at random times and checks the statistics after
+ * every operation
+ *
+ * The values have an offset and the interarrival times vary widely, so that
+ * the window goes through bursts, evictions of many entries, and empty
+ * periods.
+ */
+void runSequence(const char* name, WindowStats& stats, InWindow inWindow,
+        unsigned run, mt19937_64& rng) {
+    const unsigned STEPS = 20000;
+
+    uniform_real_distribution<double> offsetDist(-1e3, 1e3);
+    uniform_real_distribution<double> scaleDist(0.1, 100);
+    exponential_distribution<double> gapDist(1.0);
+    uniform_real_distribution<double> unit(0, 1);
+
+    double offset = offsetDist(rng);
+    normal_distribution<double> valueDist(offset, scaleDist(rng));
+
+    vector<Entry> entries;
+    for (unsigned step = 0; step < STEPS; step++) {
+        double u = unit(rng);
+        if (u < 0.01) {
+
+            /* long gap: the whole window expires */
+            ManualClock::current += WINDOW * (1 + unit(rng));
+        } else if (u < 0.3) {
+            ManualClock::current += gapDist(rng);
+        } else if (u < 0.5) {
+            ManualClock::current += gapDist(rng) / 100;
+        } // else, same timestamp as the previous entry
+
+        double value = valueDist(rng);
+        stats.record(value);
+        entries.push_back(Entry { ManualClock::current, value });
+
+        double now = ManualClock::current;
+        Expected expected(entries, inWindow, now);
+        double scale = fabs(offset) + valueDist.stddev();
+        check(name, "count", stats.getCount(), expected.count, 0, run, step);
+        check(name, "mean", stats.getAverage(), expected.mean, scale, run, step);
+        check(name, "variance", stats.getVariance(), expected.variance, scale * scale, run, step);
+
+        /* keep the brute-force list short */
+        entries.erase(remove_if(entries.begin(), entries.end(),
+                [&](const Entry& entry) { return !inWindow(entry.timestamp, now); }),
+                entries.end());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const unsigned RUNS = 20;
+    const unsigned BUCKETS = 8;
+    unsigned seed = (argc > 1) ? atoi(argv[1]) : 0;
+    mt19937_64 rng(seed);
+
+    for (unsigned run = 0; run < RUNS; run++) {
+        ManualClock::current = 0;
+        BasicTimeWindowStats<ManualClock> stats;
+        stats.setWindow(WINDOW);
+        runSequence("TimeWindowStats", stats,
+                [&](double timestamp, double now) { return timestamp >= now - WINDOW; },
+                run, rng);
+    }
+
+    /*
+     * the bucketed stats cover the buckets whose time slot is among the
+     * last BUCKETS ones
+     */
+    for (unsigned run = 0; run < RUNS; run++) {
+        ManualClock::current = 0;
+        BasicBucketedTimeWindowStats<ManualClock> stats(BUCKETS);
+        stats.setWindow(WINDOW);
+        double width = ManualClock::divide(WINDOW, BUCKETS);
+        runSequence("BucketedTimeWindowStats", stats,
+                [&](double timestamp, double now) {
+                    return ManualClock::getSlot(timestamp, width) > ManualClock::getSlot(now, width) - (long) BUCKETS;
+                },
+                run, rng);
+    }
+
+    /* no time has elapsed since the start, so there is no rate yet */
+    ManualClock::current = 0;
+    BasicTimeWindowStats<ManualClock> fresh;
+    BasicBucketedTimeWindowStats<ManualClock> freshBucketed(BUCKETS);
+    fresh.record(1);
+    freshBucketed.record(1);
+    check("TimeWindowStats", "rate at start", fresh.getRate(), 0, 0, 0, 0);
+    check("BucketedTimeWindowStats", "rate at start", freshBucketed.getRate(), 0, 0, 0, 0);
+
+    if (failures > 0) {
+        cerr << failures << " checks failed" << endl;
+        return 1;
+    }
+
+    cout << "windowstats_test: " << 2 * RUNS << " runs passed" << endl;
+    return 0;
+}